@@ -5,62 +5,222 @@ namespace emu
     Clock::Clock()
         : mTargetTick(0)
         , mExecutedTick(0)
+        , mQuantum(Scheduler::NEVER)
     {
     }
 
     Clock::~Clock()
     {
+        stopThreads();
     }
 
-    bool Clock::create()
+    bool Clock::create(const Config& config)
     {
+        EMU_VERIFY(config.maxSkew > 0);
+        EMU_VERIFY((config.minQuantum > 0) && (config.minQuantum <= config.maxQuantum));
+        mConfig = config;
+        mQuantum = config.maxQuantum;
+        EMU_VERIFY(mScheduler.create(SCHEDULER_CAPACITY));
         return true;
     }
 
-    void Clock::execute(int32_t tick)
+    void Clock::execute(Tick tick)
     {
+        if (mConfig.threaded)
+            startThreads();
+
         while (getExecutedTick() < tick)
         {
-            // Advance masters until a desired target tick is reached
-            mTargetTick = tick;
-            while (getExecutedTick() < mTargetTick)
-            {
-                int32_t masterTick = mTargetTick;
-                for (auto clocked : mClockedMasters)
-                {
-                    int32_t executedTick = clocked->execute(mTargetTick);
-                    masterTick = std::min(masterTick, executedTick);
-                }
-                mExecutedTick = masterTick;
-
-                // TODO: Target tick should be the minimum from a list of scheduled operations
-                mTargetTick = masterTick;
-            }
+            // Dispatch due events first, they may schedule new ones that change the next target
+            mScheduler.execute(mExecutedTick);
+
+            // Advance masters until the next scheduled event, the end of the quantum or the desired target tick.
+            // Only an event can wake masters that are all idle, the quantum is skipped then.
+            bool idle = mIdleMasters.load(std::memory_order_relaxed) >= mClockedMasters.size();
+            Tick quantumTick = (!idle && (mQuantum < Scheduler::NEVER - mExecutedTick)) ? mExecutedTick + mQuantum : Scheduler::NEVER;
+            mTargetTick = std::min(std::min(tick, mScheduler.getNextTick()), quantumTick);
+            Tick masterTick = mConfig.threaded ? executeMastersThreaded(mTargetTick) : executeMasters(mTargetTick);
+            updateQuantum(std::max<Tick>(masterTick - mExecutedTick, 0));
+            mExecutedTick = std::max(mExecutedTick, masterTick);
 
-            // Advance slaves to the target tick
+            // Advance slaves to where all masters are
             for (auto clocked : mClockedSlaves)
             {
-                clocked->execute(mTargetTick);
+                clocked->execute(mExecutedTick);
             }
         }
+
+        // Workers park until the next call instead of spinning between frames
+        mRunning.store(false, std::memory_order_release);
+        mScheduler.execute(mExecutedTick);
+    }
+
+    void Clock::updateQuantum(Tick slice)
+    {
+        bool interaction = mInteraction.exchange(false, std::memory_order_relaxed);
+        if (interaction)
+        {
+            mQuantum = mConfig.minQuantum;
+            ++mQuantumStats.interactions;
+        }
+        else if (mQuantum < mConfig.maxQuantum)
+        {
+            mQuantum = (mQuantum < (mConfig.maxQuantum >> 1)) ? (mQuantum << 1) : mConfig.maxQuantum;
+        }
+
+        ++mQuantumStats.slices;
+        mQuantumStats.executedTicks += slice;
+        mQuantumStats.shortestSlice = std::min(mQuantumStats.shortestSlice, slice);
+        mQuantumStats.longestSlice = std::max(mQuantumStats.longestSlice, slice);
     }
 
-    void Clock::advance(int32_t tick)
+    Tick Clock::executeMasters(Tick tick)
     {
+        Tick masterTick = tick;
         for (auto clocked : mClockedMasters)
-            clocked->advance(tick);
-        for (auto clocked : mClockedSlaves)
-            clocked->advance(tick);
+        {
+            Tick executedTick = clocked->execute(tick);
+            masterTick = std::min(masterTick, executedTick);
+        }
+        return masterTick;
+    }
+
+    Tick Clock::executeMastersThreaded(Tick tick)
+    {
+        if (mWorkers.empty())
+            return tick;
+
+        // Masters run concurrently in windows no longer than the allowed skew, each window ends with a barrier
+        Tick masterTick = mExecutedTick;
+        while (masterTick < tick)
+        {
+            Tick windowTick = std::min(tick, masterTick + mConfig.maxSkew);
+            mWindowTick.store(windowTick, std::memory_order_release);
+            for (size_t index = 1; index < mWorkers.size(); ++index)
+                mWorkers[index]->targetTick.store(windowTick, std::memory_order_release);
+
+            // The first master runs on the calling thread
+            auto& local = *mWorkers[0];
+            local.executedTick.store(local.clocked->execute(windowTick), std::memory_order_release);
+
+            masterTick = local.executedTick.load(std::memory_order_relaxed);
+            for (size_t index = 1; index < mWorkers.size(); ++index)
+            {
+                auto& worker = *mWorkers[index];
+                Tick executedTick;
+                while ((executedTick = worker.executedTick.load(std::memory_order_acquire)) < windowTick)
+                    std::this_thread::yield();
+                masterTick = std::min(masterTick, executedTick);
+            }
+        }
+        return std::min(masterTick, tick);
+    }
+
+    void Clock::synchronize(IClocked& clocked, Tick tick)
+    {
+        notifyInteraction();
+        if (mWorkers.empty())
+            return;
+
+        // Publish our progress then wait for the other masters to catch up, or to reach the end of the window.
+        // Two masters waiting on each other always unblock since one of them is behind the other.
+        Worker* self = nullptr;
+        for (auto& worker : mWorkers)
+        {
+            if (worker->clocked == &clocked)
+                self = worker.get();
+        }
+        if (!self)
+            return;
+        self->executedTick.store(tick, std::memory_order_release);
+
+        Tick limit = std::min(tick, mWindowTick.load(std::memory_order_acquire));
+        for (auto& worker : mWorkers)
+        {
+            if (worker.get() == self)
+                continue;
+            while (worker->executedTick.load(std::memory_order_acquire) < limit)
+                std::this_thread::yield();
+        }
+    }
+
+    void Clock::startThreads()
+    {
+        if (mWorkers.size() != mClockedMasters.size())
+        {
+            stopThreads();
+            for (auto clocked : mClockedMasters)
+            {
+                auto worker = std::make_unique<Worker>();
+                worker->clocked = clocked;
+                worker->targetTick = mExecutedTick;
+                worker->executedTick = mExecutedTick;
+                mWorkers.push_back(std::move(worker));
+            }
+            for (size_t index = 1; index < mWorkers.size(); ++index)
+            {
+                auto& worker = *mWorkers[index];
+                worker.thread = std::thread([this, &worker]() { runWorker(worker); });
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRunning.store(true, std::memory_order_release);
+        }
+        mCondition.notify_all();
+    }
+
+    void Clock::stopThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto& worker : mWorkers)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+        mWorkers.clear();
+        mStopping = false;
+    }
+
+    void Clock::runWorker(Worker& worker)
+    {
+        for (;;)
+        {
+            Tick targetTick = worker.targetTick.load(std::memory_order_acquire);
+            if (targetTick > worker.executedTick.load(std::memory_order_relaxed))
+            {
+                worker.executedTick.store(worker.clocked->execute(targetTick), std::memory_order_release);
+                continue;
+            }
+
+            if (mRunning.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [this]() { return mRunning.load(std::memory_order_relaxed) || mStopping; });
+            if (mStopping)
+                return;
+        }
     }
 
     void Clock::addClocked(IClocked& clocked, bool master)
     {
+        stopThreads();
         auto& list = master ? mClockedMasters : mClockedSlaves;
         list.push_back(&clocked);
     }
 
     void Clock::removeClocked(IClocked& clocked, bool master)
     {
+        stopThreads();
         auto& list = master ? mClockedMasters : mClockedSlaves;
         auto item = std::find(list.begin(), list.end(), &clocked);
         list.erase(item);
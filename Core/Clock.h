@@ -1,44 +1,179 @@
 #pragma once
 
 #include "Core.h"
+#include "Scheduler.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace emu
 {
+    // Converts between clock ticks and the cycles of a component running at an integer fraction of the clock.
+    // Power of two ratios use shifts, other ratios a multiply, only the rounding of slice targets divides.
+    class ClockDivider
+    {
+    public:
+        bool create(uint32_t divider)
+        {
+            EMU_VERIFY(divider > 0);
+            mDivider = divider;
+            mShift = -1;
+            if ((divider & (divider - 1)) == 0)
+            {
+                mShift = 0;
+                while ((1u << mShift) < divider)
+                    ++mShift;
+            }
+            return true;
+        }
+
+        Tick toTicks(int64_t cycles) const
+        {
+            return (mShift >= 0) ? (cycles << mShift) : (cycles * mDivider);
+        }
+
+        // Rounds up so that the converted cycles always cover the requested tick
+        int64_t toCycles(Tick tick) const
+        {
+            if (mShift >= 0)
+                return (tick + (static_cast<Tick>(1) << mShift) - 1) >> mShift;
+            return (tick + mDivider - 1) / mDivider;
+        }
+
+        uint32_t getDivider() const
+        {
+            return mDivider;
+        }
+
+    private:
+        uint32_t        mDivider{ 1 };
+        int32_t         mShift{ 0 };
+    };
+
     class Clock
     {
     public:
         class IClocked
         {
         public:
-            virtual int32_t execute(int32_t tick) = 0;
-            virtual void advance(int32_t tick) = 0;
+            virtual Tick execute(Tick tick) = 0;
+        };
+
+        struct Config
+        {
+            // Masters other than the first one run on their own host thread
+            bool        threaded{ false };
+            // Largest distance in ticks that threaded masters may drift apart between barriers
+            Tick        maxSkew{ 1024 };
+            // Slices double up to the longest quantum while masters run independently and drop to the shortest
+            // one after an interaction. Leaving both at NEVER only splits slices at scheduled events.
+            Tick        minQuantum{ Scheduler::NEVER };
+            Tick        maxQuantum{ Scheduler::NEVER };
+        };
+
+        struct QuantumStats
+        {
+            uint64_t    slices{ 0 };
+            uint64_t    interactions{ 0 };
+            Tick        executedTicks{ 0 };
+            Tick        shortestSlice{ Scheduler::NEVER };
+            Tick        longestSlice{ 0 };
         };
 
         Clock();
         ~Clock();
-        bool create();
-        void execute(int32_t tick);
-        void advance(int32_t tick);
+        bool create(const Config& config);
+        void execute(Tick tick);
         void addClocked(IClocked& clocked, bool master = false);
         void removeClocked(IClocked& clocked, bool master = false);
+        void synchronize(IClocked& clocked, Tick tick);
 
-        int32_t getTargetTick() const
+        // Devices report traffic between masters so the next slices get shorter
+        void notifyInteraction()
+        {
+            mInteraction.store(true, std::memory_order_relaxed);
+        }
+
+        // Halted masters report themselves idle, slices only end at scheduled events while all of them are
+        void notifyIdle(bool idle)
+        {
+            if (idle)
+                mIdleMasters.fetch_add(1, std::memory_order_relaxed);
+            else
+                mIdleMasters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        Tick getQuantum() const
+        {
+            return mQuantum;
+        }
+
+        const QuantumStats& getQuantumStats() const
+        {
+            return mQuantumStats;
+        }
+
+        void resetQuantumStats()
+        {
+            mQuantumStats = QuantumStats();
+        }
+
+        Tick getTargetTick() const
         {
             return mTargetTick;
         }
 
-        int32_t getExecutedTick() const
+        Tick getExecutedTick() const
         {
             return mExecutedTick;
         }
 
+        Scheduler& getScheduler()
+        {
+            return mScheduler;
+        }
+
     private:
         typedef std::vector<IClocked*> ClockedList;
 
-        ClockedList     mClockedMasters;
-        ClockedList     mClockedSlaves;
-        int32_t         mTargetTick;
-        int32_t         mExecutedTick;
+        static const size_t SCHEDULER_CAPACITY = 64;
+
+        // Handoff between the clock and a master is lock free, the worker only blocks between calls to execute
+        struct Worker
+        {
+            IClocked*           clocked{ nullptr };
+            std::thread         thread;
+            std::atomic<Tick>   targetTick{ 0 };
+            std::atomic<Tick>   executedTick{ 0 };
+        };
+
+        typedef std::vector<std::unique_ptr<Worker>> WorkerList;
+
+        void updateQuantum(Tick slice);
+        Tick executeMasters(Tick tick);
+        Tick executeMastersThreaded(Tick tick);
+        void startThreads();
+        void stopThreads();
+        void runWorker(Worker& worker);
+
+        Config                  mConfig;
+        ClockedList             mClockedMasters;
+        ClockedList             mClockedSlaves;
+        Scheduler               mScheduler;
+        Tick                    mTargetTick;
+        Tick                    mExecutedTick;
+        Tick                    mQuantum;
+        std::atomic<bool>       mInteraction{ false };
+        std::atomic<size_t>     mIdleMasters{ 0 };
+        QuantumStats            mQuantumStats;
+        WorkerList              mWorkers;
+        std::atomic<Tick>       mWindowTick{ 0 };
+        std::mutex              mMutex;
+        std::condition_variable mCondition;
+        std::atomic<bool>       mRunning{ false };
+        bool                    mStopping{ false };
     };
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#define EMU_CONFIG_LITTLE_ENDIAN    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define EMU_CONFIG_BIG_ENDIAN       (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define EMU_CONFIG_DIR_SEPARATOR    '/'
+
+#if defined(__x86_64__)
+#define EMU_CONFIG_JIT              1
+#else
+#define EMU_CONFIG_JIT              0
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+#define EMU_PLATFORM_SWAP16(val)    (__builtin_bswap16(val))
+#define EMU_PLATFORM_SWAP32(val)    (__builtin_bswap32(val))
+#define EMU_PLATFORM_SWAP64(val)    (__builtin_bswap64(val))
+
+namespace emu
+{
+    namespace platform
+    {
+        inline bool findFirstBit(size_t& pos, uint32_t mask)
+        {
+            if (!mask)
+                return false;
+            pos = static_cast<size_t>(__builtin_ctz(mask));
+            return true;
+        }
+
+        inline bool findFirstBit(size_t& pos, uint64_t mask)
+        {
+            if (!mask)
+                return false;
+            pos = static_cast<size_t>(__builtin_ctzll(mask));
+            return true;
+        }
+
+        inline bool findLastBit(size_t& pos, uint32_t mask)
+        {
+            if (!mask)
+                return false;
+            pos = static_cast<size_t>(31 - __builtin_clz(mask));
+            return true;
+        }
+
+        inline bool findLastBit(size_t& pos, uint64_t mask)
+        {
+            if (!mask)
+                return false;
+            pos = static_cast<size_t>(63 - __builtin_clzll(mask));
+            return true;
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #define EMU_CONFIG_LITTLE_ENDIAN    1
 #define EMU_CONFIG_BIG_ENDIAN       0
 #define EMU_CONFIG_DIR_SEPARATOR    '\\'
+#define EMU_CONFIG_JIT              0
 
 #include <intrin.h>
 #include <stdint.h>
@@ -1,6 +1,26 @@
 #pragma once
 
+#if defined(_WIN32)
 #include "ConfigWindows.h"
+#elif defined(__linux__)
+#include "ConfigLinux.h"
+#endif
+
+// Memory access statistics are compiled out unless requested by the build
+#if !defined(EMU_CONFIG_MEMORY_STATS)
+#define EMU_CONFIG_MEMORY_STATS     0
+#endif
+
+// Generated code doesn't count memory accesses, statistics builds always interpret
+#if EMU_CONFIG_MEMORY_STATS
+#undef EMU_CONFIG_JIT
+#define EMU_CONFIG_JIT              0
+#endif
+
+// Running clock masters on their own host threads is opt-in until all shared devices synchronize
+#if !defined(EMU_CONFIG_THREADED_CLOCK)
+#define EMU_CONFIG_THREADED_CLOCK   0
+#endif
 
 #include <algorithm>
 #include <cstddef>
@@ -66,6 +86,9 @@
 
 namespace emu
 {
+    // Absolute timestamp in the master clock domain, never rebased
+    typedef int64_t Tick;
+
     template<typename>
     struct RemoveTypeParenthesis;
 
@@ -11,7 +11,7 @@ namespace
     };
 #undef INSTRUCTION
 
-#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(Insn::##insn),
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(Insn::insn),
     const uint8_t CpuArmDisassembler::insnTable[] =
     {
 #include "CpuTablesARM7TDMI.inl"
@@ -19,11 +19,34 @@ namespace
 #undef INSTRUCTION
 
 #define INSTRUCTION(known, prefix, insn, addr)  &CpuArmInterpreter::insn_##prefix<known>,
+    template <>
     const CpuArmInterpreter::InterpretedFunction CpuArmInterpreter::insnTable[] =
     {
 #include "CpuTablesARM7TDMI.inl"
     };
 #undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(EMU_GET_MACRO_ARG_TYPE(addr)::getAddr()),
+    const uint8_t CpuArmDisassembler::thumbAddrTable[] =
+    {
+#include "CpuTablesThumbARM7TDMI.inl"
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(ThumbInsn::insn),
+    const uint8_t CpuArmDisassembler::thumbInsnTable[] =
+    {
+#include "CpuTablesThumbARM7TDMI.inl"
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  &CpuArmInterpreter::thumb_##prefix<known>,
+    template <>
+    const CpuArmInterpreter::InterpretedFunction CpuArmInterpreter::thumbTable[] =
+    {
+#include "CpuTablesThumbARM7TDMI.inl"
+    };
+#undef INSTRUCTION
 }
 
 namespace emu
@@ -11,7 +11,7 @@ namespace
     };
 #undef INSTRUCTION
 
-#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(Insn::##insn),
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(Insn::insn),
     const uint8_t CpuArmDisassembler::insnTable[] =
     {
 #include "CpuTablesARM946ES.inl"
@@ -19,11 +19,34 @@ namespace
 #undef INSTRUCTION
 
 #define INSTRUCTION(known, prefix, insn, addr)  &CpuArmInterpreter::insn_##prefix<known>,
+    template <>
     const CpuArmInterpreter::InterpretedFunction CpuArmInterpreter::insnTable[] =
     {
 #include "CpuTablesARM946ES.inl"
     };
 #undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(EMU_GET_MACRO_ARG_TYPE(addr)::getAddr()),
+    const uint8_t CpuArmDisassembler::thumbAddrTable[] =
+    {
+#include "CpuTablesThumbARM946ES.inl"
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  static_cast<uint8_t>(ThumbInsn::insn),
+    const uint8_t CpuArmDisassembler::thumbInsnTable[] =
+    {
+#include "CpuTablesThumbARM946ES.inl"
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  &CpuArmInterpreter::thumb_##prefix<known>,
+    template <>
+    const CpuArmInterpreter::InterpretedFunction CpuArmInterpreter::thumbTable[] =
+    {
+#include "CpuTablesThumbARM946ES.inl"
+    };
+#undef INSTRUCTION
 }
 
 namespace emu
@@ -37,4 +60,15 @@ namespace emu
     {
         return static_cast<CpuArmInterpreter*>(static_cast<CpuArm*>(this))->interpretImpl();
     }
+
+    void ARM946ES::writeCoprocessor(uint32_t cp, uint32_t opcode1, uint32_t crn, uint32_t crm, uint32_t opcode2, uint32_t)
+    {
+        // CP15 c7 wait for interrupt, both the c0,4 and the c8,2 encodings
+        if ((cp == 15) && (opcode1 == 0) && (crn == 7) && (((crm == 0) && (opcode2 == 4)) || ((crm == 8) && (opcode2 == 2))))
+        {
+            halt();
+            return;
+        }
+        EMU_NOT_IMPLEMENTED();
+    }
 }
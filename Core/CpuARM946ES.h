@@ -9,5 +9,8 @@ namespace emu
     public:
         virtual uint32_t disassemble(char* buffer, size_t size, uint32_t addr, bool thumb) override;
         virtual uint32_t execute() override;
+
+    protected:
+        virtual void writeCoprocessor(uint32_t cp, uint32_t opcode1, uint32_t crn, uint32_t crm, uint32_t opcode2, uint32_t value) override;
     };
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Clock.h"
 #include "CpuArm.h"
+#include "CpuArmJit.h"
+#include <cstring>
 
 namespace emu
 {
@@ -16,29 +18,66 @@ namespace emu
         mConfig = config;
         mMemory = &memory;
         mClock = &clock;
-        mClockDivider = clockDivider;
-        mExecutedTick = 0;
+        EMU_VERIFY(mClockDivider.create(clockDivider));
+        mExecutedCycles = 0;
+        mTargetCycles = 0;
+        mBlocks.clear();
+        if (config.cacheBlocks)
+        {
+            EMU_VERIFY(mMemory->enableDirtyTracking());
+            Block block = {};
+            block.addr = BLOCK_INVALID;
+            mBlocks.assign(BLOCK_CACHE_SIZE, block);
+        }
+#if EMU_CONFIG_JIT
+        mJit.reset();
+        if (config.cacheBlocks && config.jit)
+        {
+            mJit.reset(new CpuArmJit());
+            EMU_VERIFY(mJit->create(*this, JIT_CODE_SIZE));
+        }
+#endif
+        mMemory->setWatchDelegate(MemoryBus32::WatchDelegate::make<CpuArm, &CpuArm::onWatch>(this));
         mClock->addClocked(*this, true);
         return true;
     }
 
-    int32_t CpuArm::execute(int32_t tick)
+    Tick CpuArm::execute(Tick tick)
     {
-        for (uint32_t index = 0; index < 25; ++index)
+        // The target is converted once per slice, instructions only accumulate cycles in the CPU clock domain
+        int64_t targetCycles = mClockDivider.toCycles(tick);
+        mTargetCycles = targetCycles;
+        while (mExecutedCycles < targetCycles)
         {
-            trace();
-            mExecutedTick += execute();
-            prefetch32();
+            // A halted CPU gives the rest of the slice back to the clock until an interrupt wakes it up
+            if (mHalted.load(std::memory_order_acquire))
+            {
+                mIdleStats.haltedCycles += targetCycles - mExecutedCycles;
+                mExecutedCycles = targetCycles;
+                break;
+            }
+
+            if (mConfig.trace)
+                trace();
+            mExecutedCycles += execute();
+            prefetch();
+
+            // Nothing an idle loop polls can change before the end of the slice, which stops at the next event
+            if (mIdleLoop)
+            {
+                mIdleLoop = false;
+                ++mIdleStats.loops;
+                if (mExecutedCycles < targetCycles)
+                {
+                    mIdleStats.skippedCycles += targetCycles - mExecutedCycles;
+                    mExecutedCycles = targetCycles;
+                }
+            }
         }
-        printf("\n");
-
-        mExecutedTick = tick;
-        return tick;
-    }
 
-    void CpuArm::advance(int32_t tick)
-    {
-        mExecutedTick -= tick;
+        // Registers are only observed between slices
+        resolveFlags();
+        return mClockDivider.toTicks(mExecutedCycles);
     }
 
     void CpuArm::reset()
@@ -57,56 +96,169 @@ namespace emu
         regExport(MODE_UND);
         regExport(MODE_SYS);
         flagsImport();
+        if (mHalted.exchange(false))
+            mClock->notifyIdle(false);
     }
 
     void CpuArm::setPC(uint32_t addr)
     {
         mPC = mPCNext = mRegisters.r[15] = addr;
-        prefetch32();
+        mFetchSequential = false;
+        prefetch();
     }
 
-#ifdef EMU_CONFIG_LITTLE_ENDIAN
-#define ENDIAN_BITS_8   0x0
-#define ENDIAN_BITS_16  0x0
-#else
-#define ENDIAN_BITS_8   0x3
-#define ENDIAN_BITS_16  0x1
-#endif
-
     uint8_t CpuArm::read8(uint32_t addr)
     {
-        uint32_t mem = mMemory->read(addr & ~0x3);
-        return reinterpret_cast<const uint8_t*>(&mem)[(addr & 0x3) ^ ENDIAN_BITS_8];
+        idleLoad(addr);
+        mFetchSequential = false;
+        return mMemory->read8(addr, mAccessCycles, false);
     }
 
     uint16_t CpuArm::read16(uint32_t addr)
     {
-        uint32_t mem = mMemory->read(addr & ~0x1);
-        return reinterpret_cast<const uint16_t*>(&mem)[(addr & 0x1) ^ ENDIAN_BITS_16];
+        idleLoad(addr);
+        mFetchSequential = false;
+        return mMemory->read16(addr & ~0x1, mAccessCycles, false);
     }
 
     uint32_t CpuArm::read32(uint32_t addr)
     {
-        return mMemory->read(addr);
+        idleLoad(addr);
+        mFetchSequential = false;
+        return mMemory->read32(addr, mAccessCycles, false);
     }
 
     void CpuArm::write8(uint32_t addr, uint8_t value)
     {
-        uint32_t mem = mMemory->read(addr & ~0x3);
-        reinterpret_cast<uint8_t*>(&mem)[(addr & 0x3) ^ ENDIAN_BITS_8] = value;
-        mMemory->write(addr & ~0x3, mem);
+        idleStore();
+        mFetchSequential = false;
+        mMemory->write8(addr, value, mAccessCycles, false);
     }
 
     void CpuArm::write16(uint32_t addr, uint16_t value)
     {
-        uint32_t mem = mMemory->read(addr & ~0x1);
-        reinterpret_cast<uint16_t*>(&mem)[(addr & 0x1) ^ ENDIAN_BITS_8] = value;
-        mMemory->write(addr & ~0x1, mem);
+        idleStore();
+        mFetchSequential = false;
+        mMemory->write16(addr & ~0x1, value, mAccessCycles, false);
     }
 
     void CpuArm::write32(uint32_t addr, uint32_t value)
     {
-        mMemory->write(addr, value);
+        idleStore();
+        mFetchSequential = false;
+        mMemory->write32(addr, value, mAccessCycles, false);
+    }
+
+    uint32_t CpuArm::fetch32(uint32_t addr)
+    {
+        // Opcode fetches are sequential until a data access or a branch breaks the stream
+        uint32_t opcode = mMemory->read32(addr, mAccessCycles, mFetchSequential);
+        mFetchSequential = true;
+        return opcode;
+    }
+
+    void CpuArm::setWatchDelegate(WatchDelegate value)
+    {
+        mWatchDelegate = value;
+    }
+
+    void CpuArm::setInterruptDelegate(InterruptDelegate value)
+    {
+        mInterruptDelegate = value;
+    }
+
+    void CpuArm::waitForInterrupt(uint32_t mask)
+    {
+        // An interrupt raised before the CPU halted ends the wait right away
+        mWaitMask = mask;
+        mClock->notifyIdle(true);
+        mHalted.store(true, std::memory_order_release);
+        wake();
+    }
+
+    // Called by the interrupt controller each time its pending interrupts change, possibly from another master
+    void CpuArm::wake()
+    {
+        if (mHalted.load(std::memory_order_acquire) && (mInterruptDelegate() & mWaitMask) && mHalted.exchange(false))
+            mClock->notifyIdle(false);
+    }
+
+    void CpuArm::swi(uint32_t)
+    {
+        EMU_NOT_IMPLEMENTED();
+    }
+
+    void CpuArm::writeCoprocessor(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t)
+    {
+        EMU_NOT_IMPLEMENTED();
+    }
+
+    CpuArm::Block* CpuArm::findBlock(uint32_t addr)
+    {
+        // Writes to a page holding blocks mark it dirty, its blocks are dropped before running any of them
+        if (mMemory->isDirty(addr))
+        {
+            uint32_t pageSize = mMemory->getFastPageSize();
+            mMemory->takeDirtyPages(addr & ~(pageSize - 1), pageSize, [this](uint32_t pageBase)
+            {
+                invalidateBlocks(pageBase);
+            });
+        }
+        return &mBlocks[(addr >> 1) & (BLOCK_CACHE_SIZE - 1)];
+    }
+
+    void CpuArm::invalidateBlocks(uint32_t pageBase)
+    {
+        uint32_t pageMask = ~(mMemory->getFastPageSize() - 1);
+        for (auto& block : mBlocks)
+        {
+            if ((block.addr & pageMask) == pageBase)
+                block.addr = BLOCK_INVALID;
+        }
+    }
+
+    void CpuArm::synchronize()
+    {
+        // Devices shared with other masters call this before touching state they can observe
+        mClock->synchronize(*this, mClockDivider.toTicks(mExecutedCycles));
+    }
+
+    void CpuArm::onWatch(uint32_t addr, uint32_t value, uint32_t size, bool write)
+    {
+        // Watches fire while the instruction at mPC is executing
+        mWatchDelegate(mPC, addr, value, size, write);
+    }
+
+    void CpuArm::detectIdleLoop()
+    {
+        // A pass through the loop without stores or memory loads that leaves every register unchanged will repeat
+        // itself until a device changes state
+        resolveFlags();
+        if (mIdleProbing && (mIdleBranchPC == mPC) && (memcmp(&mIdleRegisters, &mRegisters, sizeof(mRegisters)) == 0))
+        {
+            mIdleLoop = true;
+            return;
+        }
+        mIdleProbing = true;
+        mIdleBranchPC = mPC;
+        mIdleRegisters = mRegisters;
+    }
+
+    void CpuArm::prefetch()
+    {
+        // Instructions switching state branch, so the state found here is the one of the next instruction
+        if (isThumb())
+            prefetch16();
+        else
+            prefetch32();
+    }
+
+    void CpuArm::prefetch16()
+    {
+        uint32_t pc = mPCNext;
+        mPC = pc;
+        mPCNext = pc + 2;
+        mRegisters.r[15] = pc + 4;
     }
 
     void CpuArm::prefetch32()
@@ -119,22 +271,17 @@ namespace emu
 
     void CpuArm::flagsExport()
     {
-        uint32_t value_v = mRegisters.flag_v ? 1 : 0;
-        uint32_t value_c = mRegisters.flag_c ? 1 : 0;
-        uint32_t value_z = mRegisters.flag_z ? 0 : 1;
-        uint32_t value_n = static_cast<int32_t>(mRegisters.flag_n) < 0 ? 1 : 0;
-        EMU_BIT_SET(CPSR_V, mRegisters.flag_v, value_v);
-        EMU_BIT_SET(CPSR_C, mRegisters.flag_c, value_c);
-        EMU_BIT_SET(CPSR_Z, mRegisters.flag_z, value_z);
-        EMU_BIT_SET(CPSR_N, mRegisters.flag_n, value_n);
+        resolveFlags();
+        mRegisters.cpsr = (mRegisters.cpsr & ~(0xfU << CPSR_V)) | (getPackedFlags() << CPSR_V);
     }
 
     void CpuArm::flagsImport()
     {
-        mRegisters.flag_v = EMU_BIT_GET(CPSR_V, mRegisters.cpsr) ? 1 : 0;
-        mRegisters.flag_c = EMU_BIT_GET(CPSR_C, mRegisters.cpsr) ? 1 : 0;
-        mRegisters.flag_z = EMU_BIT_GET(CPSR_Z, mRegisters.cpsr) ? 0 : 1;
-        mRegisters.flag_n = EMU_BIT_GET(CPSR_N, mRegisters.cpsr) ? -1 : 0;
+        mRegisters.flag_v = static_cast<uint8_t>(EMU_BIT_GET(CPSR_V, mRegisters.cpsr));
+        mRegisters.flag_c = static_cast<uint8_t>(EMU_BIT_GET(CPSR_C, mRegisters.cpsr));
+        mRegisters.flag_z = static_cast<uint8_t>(EMU_BIT_GET(CPSR_Z, mRegisters.cpsr));
+        mRegisters.flag_n = static_cast<uint8_t>(EMU_BIT_GET(CPSR_N, mRegisters.cpsr));
+        mFlagsPending = FLAGS_PENDING_NONE;
     }
 
     void CpuArm::regExport(uint32_t mode)
@@ -237,9 +384,9 @@ namespace emu
 
     void CpuArm::trace()
     {
-        bool thumb = EMU_BIT_GET(CPSR_T, mRegisters.cpsr) != 0;
+        bool thumb = isThumb();
         char disassembly[32];
-        uint32_t data = read32(mPC);
+        uint32_t data = mMemory->read32(mPC);
         disassemble(disassembly, sizeof(disassembly), mPC, thumb);
         printf("%08X %08X %-32s\n", data, mPC, disassembly);
     }
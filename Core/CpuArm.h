@@ -3,14 +3,37 @@
 #include "Clock.h"
 #include "Core.h"
 #include "MemoryBus.h"
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace emu
 {
+    class CpuArmJit;
+
     class CpuArm : public Clock::IClocked
     {
     public:
+        typedef Delegate<void(uint32_t pc, uint32_t addr, uint32_t value, uint32_t size, bool write)> WatchDelegate;
+        // Returns the interrupts currently raised and enabled, checked when the CPU halts and when it is woken
+        typedef Delegate<uint32_t()> InterruptDelegate;
+
         struct Config
         {
+            bool        trace{ false };
+            bool        skipIdleLoops{ true };
+            // Decoded blocks are invalidated through dirty tracking, which this enables on the bus. Writes from other buses
+            // or through mirrors are only seen for memory whose accessor has a dirty tracker.
+            bool        cacheBlocks{ false };
+            // Translates cached blocks to host code, ignored without block caching or on hosts without a JIT
+            bool        jit{ false };
+        };
+
+        struct IdleStats
+        {
+            uint64_t    loops{ 0 };
+            uint64_t    skippedCycles{ 0 };
+            uint64_t    haltedCycles{ 0 };
         };
 
         struct Registers
@@ -58,17 +81,17 @@ namespace emu
                 uint32_t    r14;
                 uint32_t    spsr;
             }               und;
-            uint32_t        flag_v;
-            uint32_t        flag_c;
-            uint32_t        flag_z;
-            uint32_t        flag_n;
+            // Each flag is 0 or 1, one byte each so that all four pack with a single load
+            uint8_t         flag_v;
+            uint8_t         flag_c;
+            uint8_t         flag_z;
+            uint8_t         flag_n;
         };
 
         CpuArm();
         ~CpuArm();
         bool create(const Config& config, MemoryBus32& memory, Clock& clock, uint32_t clockDivider);
-        virtual int32_t execute(int32_t tick) override;
-        virtual void advance(int32_t tick) override;
+        virtual Tick execute(Tick tick) override;
         void reset();
         void setPC(uint32_t addr);
         uint8_t read8(uint32_t addr);
@@ -77,6 +100,18 @@ namespace emu
         void write8(uint32_t addr, uint8_t value);
         void write16(uint32_t addr, uint16_t value);
         void write32(uint32_t addr, uint32_t value);
+        uint32_t fetch32(uint32_t addr);
+        void setWatchDelegate(WatchDelegate value);
+        void setInterruptDelegate(InterruptDelegate value);
+        void synchronize();
+        void waitForInterrupt(uint32_t mask);
+        void wake();
+
+        void halt()
+        {
+            waitForInterrupt(~0u);
+        }
+
         virtual uint32_t disassemble(char* buffer, size_t size, uint32_t addr, bool thumb) = 0;
         virtual uint32_t execute() = 0;
 
@@ -90,7 +125,15 @@ namespace emu
             return *mMemory;
         }
 
+        const IdleStats& getIdleStats() const
+        {
+            return mIdleStats;
+        }
+
     protected:
+        friend class CpuArmIr;
+        friend class CpuArmJit;
+
         static const uint32_t   MODE_USR = 0x10;
         static const uint32_t   MODE_FIQ = 0x11;
         static const uint32_t   MODE_IRQ = 0x12;
@@ -110,21 +153,254 @@ namespace emu
         static const uint32_t   CPSR_MODE_SHIFT = 0;
         static const uint32_t   CPSR_MODE_SIZE = 5;
 
+        // Backward branches at most this many bytes away are idle loop candidates
+        static const uint32_t   IDLE_LOOP_SIZE = 32;
+
+        static const uint32_t   BLOCK_SIZE = 16;
+        static const uint32_t   BLOCK_CACHE_SIZE = 2048;
+        static const uint32_t   BLOCK_INVALID = 0xffffffff;
+        static const size_t     JIT_CODE_SIZE = 4 * 1024 * 1024;
+
+        // Flag setting instructions only record their operands, the flags are computed once something reads them
+        enum FlagsPending : uint8_t
+        {
+            FLAGS_PENDING_NONE,
+            FLAGS_PENDING_LOGICAL,      // N and Z from the result
+            FLAGS_PENDING_ADD,          // N, Z, C and V from the addition of both operands and a carry in
+        };
+
+        typedef void(CpuArm::* DecodedHandler)();
+        typedef void(*CompiledFunction)(CpuArm* cpu);
+
+        // Opcode fields extracted once so handlers don't decode them again, imm depends on the instruction class
+        struct Decoded
+        {
+            DecodedHandler  handler;
+            uint32_t        opcode;
+            uint32_t        imm;
+            uint8_t         rn;
+            uint8_t         rd;
+            uint8_t         rs;
+            uint8_t         rm;
+            uint8_t         shift;
+            bool            flagsPending;   // The block can't stop here at the end of a slice
+        };
+
+        // Run of instructions within a single fast page, cached by start address and instruction set
+        struct Block
+        {
+            uint32_t        addr;
+            bool            thumb;
+            uint32_t        count;
+            const MemoryBus32::Timing* timing;
+            // Host code running the first codeCount instructions, null when the whole block is interpreted
+            CompiledFunction code;
+            uint32_t        codeCount;
+            Decoded         insns[BLOCK_SIZE];
+        };
+
+        static void decode(Decoded& decoded, uint32_t opcode)
+        {
+            decoded.opcode = opcode;
+            decoded.rn = static_cast<uint8_t>(EMU_BITS_GET(16, 4, opcode));
+            decoded.rd = static_cast<uint8_t>(EMU_BITS_GET(12, 4, opcode));
+            decoded.rs = static_cast<uint8_t>(EMU_BITS_GET(8, 4, opcode));
+            decoded.rm = static_cast<uint8_t>(EMU_BITS_GET(0, 4, opcode));
+            decoded.shift = static_cast<uint8_t>(EMU_BITS_GET(7, 5, opcode));
+            switch (EMU_BITS_GET(25, 3, opcode))
+            {
+            case 1:
+            {
+                // Data processing immediate, rotated here once
+                uint32_t imm = EMU_BITS_GET(0, 8, opcode);
+                uint32_t rotate = EMU_BITS_GET(8, 4, opcode) << 1;
+                decoded.imm = rotate ? ((imm >> rotate) | (imm << (32 - rotate))) : imm;
+                break;
+            }
+
+            case 2:
+                // Single data transfer immediate offset
+                decoded.imm = EMU_BITS_GET(0, 12, opcode);
+                break;
+
+            case 5:
+                // Branch offset in bytes
+                decoded.imm = static_cast<uint32_t>(static_cast<int32_t>(opcode << 8) >> 6);
+                break;
+
+            default:
+                decoded.imm = 0;
+                break;
+            }
+        }
+
+        // Low registers sit at the same places in most Thumb formats, imm holds the immediate or branch offset
+        static void decodeThumb(Decoded& decoded, uint32_t opcode)
+        {
+            decoded.opcode = opcode;
+            decoded.rd = static_cast<uint8_t>(EMU_BITS_GET(0, 3, opcode));
+            decoded.rn = static_cast<uint8_t>(EMU_BITS_GET(3, 3, opcode));
+            decoded.rm = static_cast<uint8_t>(EMU_BITS_GET(6, 3, opcode));
+            decoded.rs = static_cast<uint8_t>(EMU_BITS_GET(8, 3, opcode));
+            decoded.shift = static_cast<uint8_t>(EMU_BITS_GET(6, 5, opcode));
+            switch (EMU_BITS_GET(12, 4, opcode))
+            {
+            case 0xd:
+                // Conditional branch offset in bytes, the SWI number for the condition 0xf
+                if (EMU_BITS_GET(8, 4, opcode) == 0xf)
+                    decoded.imm = EMU_BITS_GET(0, 8, opcode);
+                else
+                    decoded.imm = static_cast<uint32_t>(static_cast<int32_t>(opcode << 24) >> 23);
+                break;
+
+            case 0xe:
+                // Unconditional branch offset in bytes, long branch halves keep their raw offset
+                if (!EMU_BIT_GET(11, opcode))
+                    decoded.imm = static_cast<uint32_t>(static_cast<int32_t>(opcode << 21) >> 20);
+                else
+                    decoded.imm = EMU_BITS_GET(0, 11, opcode);
+                break;
+
+            case 0xf:
+                decoded.imm = EMU_BITS_GET(0, 11, opcode);
+                break;
+
+            default:
+                decoded.imm = EMU_BITS_GET(0, 8, opcode);
+                break;
+            }
+        }
+
+        // NZCV from bit 3 to bit 0, pending flags must have been resolved
+        uint32_t getPackedFlags() const
+        {
+            return (mRegisters.flag_n << 3) | (mRegisters.flag_z << 2) | (mRegisters.flag_c << 1) | mRegisters.flag_v;
+        }
+
+        bool isThumb() const
+        {
+            return EMU_BIT_GET(CPSR_T, mRegisters.cpsr) != 0;
+        }
+
         void flagsExport();
         void flagsImport();
         void regExport(uint32_t mode);
         void regImport(uint32_t mode);
+        void prefetch();
+        void prefetch16();
         void prefetch32();
         void trace();
+        void onWatch(uint32_t addr, uint32_t value, uint32_t size, bool write);
+        void detectIdleLoop();
+        virtual void swi(uint32_t number);
+        virtual void writeCoprocessor(uint32_t cp, uint32_t opcode1, uint32_t crn, uint32_t crm, uint32_t opcode2, uint32_t value);
+        Block* findBlock(uint32_t addr);
+        void invalidateBlocks(uint32_t pageBase);
+
+        void branch(uint32_t addr)
+        {
+            if (((mPC - addr) <= IDLE_LOOP_SIZE) && mConfig.skipIdleLoops)
+                detectIdleLoop();
+            mPCNext = addr;
+            mFetchSequential = false;
+        }
+
+        // Any store or memory load ends the idle loop probe, only device reads can be repeated safely
+        void idleLoad(uint32_t addr)
+        {
+            if (mIdleProbing && mMemory->isMemory(addr))
+                mIdleProbing = false;
+        }
+
+        void idleStore()
+        {
+            mIdleProbing = false;
+        }
+
+        void setFlagsLogical(uint32_t result)
+        {
+            if (mFlagsPending == FLAGS_PENDING_ADD)
+                resolveCarryOverflow();
+            mFlagsPending = FLAGS_PENDING_LOGICAL;
+            mFlagsResult = result;
+        }
+
+        // The carry in is recovered from the result, so subtractions are recorded as additions of the complement
+        void setFlagsAdd(uint32_t operand1, uint32_t operand2, uint32_t result)
+        {
+            mFlagsPending = FLAGS_PENDING_ADD;
+            mFlagsOperand1 = operand1;
+            mFlagsOperand2 = operand2;
+            mFlagsResult = result;
+        }
+
+        void setCarry(uint32_t carry)
+        {
+            if (mFlagsPending == FLAGS_PENDING_ADD)
+                resolveCarryOverflow();
+            mRegisters.flag_c = static_cast<uint8_t>(carry);
+        }
+
+        uint32_t getCarry()
+        {
+            if (mFlagsPending == FLAGS_PENDING_ADD)
+                resolveCarryOverflow();
+            return mRegisters.flag_c;
+        }
+
+        // N and Z stay pending, they only depend on the result
+        void resolveCarryOverflow()
+        {
+            uint32_t a = mFlagsOperand1;
+            uint32_t b = mFlagsOperand2;
+            uint32_t result = mFlagsResult;
+            bool carryIn = (result - a - b) != 0;
+            mRegisters.flag_c = carryIn ? (result <= a) : (result < a);
+            mRegisters.flag_v = static_cast<uint8_t>(((a ^ result) & (b ^ result)) >> 31);
+            mFlagsPending = FLAGS_PENDING_LOGICAL;
+        }
+
+        void resolveFlags()
+        {
+            if (mFlagsPending == FLAGS_PENDING_NONE)
+                return;
+            if (mFlagsPending == FLAGS_PENDING_ADD)
+                resolveCarryOverflow();
+            mRegisters.flag_n = static_cast<uint8_t>(mFlagsResult >> 31);
+            mRegisters.flag_z = mFlagsResult == 0;
+            mFlagsPending = FLAGS_PENDING_NONE;
+        }
 
         Config          mConfig;
         MemoryBus32*    mMemory;
         Clock*          mClock;
-        uint32_t        mClockDivider;
-        uint32_t        mExecutedTick;
+        ClockDivider    mClockDivider;
+        int64_t         mExecutedCycles;
+        int64_t         mTargetCycles;
         Registers       mRegisters;
+        FlagsPending    mFlagsPending = FLAGS_PENDING_NONE;
+        uint32_t        mFlagsOperand1 = 0;
+        uint32_t        mFlagsOperand2 = 0;
+        uint32_t        mFlagsResult = 0;
         uint32_t        mPC;
         uint32_t        mPCNext;
         uint32_t        mOpcode = 0;
+        const Decoded*  mDecoded = nullptr;
+        Decoded         mDecodedScratch;
+        std::vector<Block> mBlocks;
+        uint32_t        mAccessCycles = 0;
+        bool            mFetchSequential = false;
+        WatchDelegate   mWatchDelegate;
+        bool            mIdleLoop = false;
+        bool            mIdleProbing = false;
+        uint32_t        mIdleBranchPC = 0;
+        Registers       mIdleRegisters;
+        IdleStats       mIdleStats;
+        std::atomic<bool> mHalted{ false };
+        uint32_t        mWaitMask = 0;
+        InterruptDelegate mInterruptDelegate;
+#if EMU_CONFIG_JIT
+        std::unique_ptr<CpuArmJit> mJit;
+#endif
     };
 }
\ No newline at end of file
@@ -5,10 +5,12 @@
 namespace
 {
 #include "CpuArmTables.inl"
+#include "CpuArmThumbTables.inl"
 
     struct CpuArmDisassembler : public emu::CpuArm
     {
         #include "CpuArmSymbols.inl"
+        #include "CpuArmThumbSymbols.inl"
 
         struct Invalid { constexpr static Addr getAddr() { return Addr::Invalid; } };
         struct BranchOffset { constexpr static Addr getAddr() { return Addr::BranchOffset; } };
@@ -78,6 +80,63 @@ namespace
         struct STREx { constexpr static Addr getAddr() { return Addr::STREx; } };
         struct LDREx { constexpr static Addr getAddr() { return Addr::LDREx; } };
 
+        struct ThumbInvalid { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbInvalid; } };
+        struct ThumbShiftImm { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbShiftImm; } };
+        struct ThumbAddSubReg { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAddSubReg; } };
+        struct ThumbAddSubImm { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAddSubImm; } };
+        struct ThumbImm8 { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbImm8; } };
+        struct ThumbAluReg { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAluReg; } };
+        struct ThumbHiReg { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbHiReg; } };
+        struct ThumbBranchReg { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBranchReg; } };
+        struct ThumbLoadPC { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbLoadPC; } };
+        struct ThumbMemReg { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbMemReg; } };
+
+        template <uint32_t Size>
+        struct ThumbMemImm { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbMemImm; } };
+
+        struct ThumbMemSP { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbMemSP; } };
+        struct ThumbAddPC { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAddPC; } };
+        struct ThumbAddSP { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAddSP; } };
+        struct ThumbAdjustSP { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbAdjustSP; } };
+        struct ThumbPushPop { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbPushPop; } };
+        struct ThumbBKPT { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBKPT; } };
+        struct ThumbMemBlock { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbMemBlock; } };
+        struct ThumbBranchCond { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBranchCond; } };
+        struct ThumbSWI { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbSWI; } };
+        struct ThumbBranch { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBranch; } };
+        struct ThumbBranchLinkSuffix { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBranchLinkSuffix; } };
+        struct ThumbBranchLinkPrefix { constexpr static ThumbAddr getAddr() { return ThumbAddr::ThumbBranchLinkPrefix; } };
+
+        static const char* getConditionText(uint32_t condition)
+        {
+            static const char* conditionText[] =
+            {
+                "eq",   "ne",   "cs",   "cc",
+                "mi",   "pl",   "vs",   "vc",
+                "hi",   "ls",   "ge",   "lt",
+                "gt",   "le",   "",     ""
+            };
+            return conditionText[condition];
+        }
+
+        static char* printRegisterList(char* operands, uint32_t rlist)
+        {
+            operands += sprintf(operands, "{");
+            bool first = true;
+            while (rlist)
+            {
+                size_t pos;
+                emu::platform::findFirstBit(pos, rlist);
+                if (first)
+                    first = false;
+                else
+                    operands += sprintf(operands, ", ");
+                operands += sprintf(operands, "r%d", static_cast<uint32_t>(pos));
+                rlist &= ~(1 << pos);
+            }
+            return operands + sprintf(operands, "}");
+        }
+
         uint32_t evalRORImm32(uint32_t imm, uint32_t shift)
         {
             if (!shift)
@@ -91,14 +150,6 @@ namespace
 
         void disassembleArm(char* instruction, char* operands, uint32_t pc)
         {
-            static const char* conditionText[] =
-            {
-                "eq",   "ne",   "cs",   "cc",
-                "mi",   "pl",   "vs",   "vc",
-                "hi",   "ls",   "ge",   "lt",
-                "gt",   "le",   "",     ""
-            };
-
             static const char* shiftText[] =
             {
                 "lsl", "lsr", "asr", "ror"
@@ -126,7 +177,7 @@ namespace
             uint32_t entry = (EMU_BITS_GET(20, 8, data) << 4) | EMU_BITS_GET(4, 4, data);
             uint32_t condition = EMU_BITS_GET(28, 4, data);
             Insn insn = static_cast<Insn>(insnTable[entry]);
-            instruction += sprintf(instruction, "%s%s%s", ::InsnName[static_cast<uint32_t>(insn)], conditionText[condition], ::InsnSuffix[static_cast<uint32_t>(insn)]);
+            instruction += sprintf(instruction, "%s%s%s", ::InsnName[static_cast<uint32_t>(insn)], getConditionText(condition), ::InsnSuffix[static_cast<uint32_t>(insn)]);
 
             operands[0] = 0;
             Addr addr = static_cast<Addr>(addrTable[entry]);
@@ -361,20 +412,9 @@ namespace
                 uint32_t w = EMU_BIT_GET(21, data);
                 uint32_t rn = EMU_BITS_GET(16, 4, data);
                 uint32_t rlist = EMU_BITS_GET(0, 16, data);
-                operands += sprintf(operands, "r%d%s, {", rn, w ? "!" : "");
-                bool first = true;
-                while (rlist)
-                {
-                    size_t pos;
-                    emu::platform::findFirstBit(pos, rlist);
-                    if (first)
-                        first = false;
-                    else
-                        operands += sprintf(operands, ", ");
-                    operands += sprintf(operands, "r%d", static_cast<uint32_t>(pos));
-                    rlist &= ~(1 << pos);
-                }
-                operands += sprintf(operands, "}%s", s ? "^" : "");
+                operands += sprintf(operands, "r%d%s, ", rn, w ? "!" : "");
+                operands = printRegisterList(operands, rlist);
+                operands += sprintf(operands, "%s", s ? "^" : "");
                 break;
             }
             case Addr::SWP:
@@ -442,21 +482,180 @@ namespace
             }
         }
 
+        void disassembleThumb(char* instruction, char* operands, uint32_t pc)
+        {
+            uint32_t data = read16(pc);
+            uint32_t entry = EMU_BITS_GET(6, 10, data);
+            ThumbInsn insn = static_cast<ThumbInsn>(thumbInsnTable[entry]);
+            ThumbAddr addr = static_cast<ThumbAddr>(thumbAddrTable[entry]);
+            const char* condition = (addr == ThumbAddr::ThumbBranchCond) ? getConditionText(EMU_BITS_GET(8, 4, data)) : "";
+            instruction += sprintf(instruction, "%s%s%s", ::ThumbInsnName[static_cast<uint32_t>(insn)], condition, ::ThumbInsnSuffix[static_cast<uint32_t>(insn)]);
+
+            operands[0] = 0;
+            uint32_t rd = EMU_BITS_GET(0, 3, data);
+            uint32_t rn = EMU_BITS_GET(3, 3, data);
+            uint32_t rm = EMU_BITS_GET(6, 3, data);
+            uint32_t rh = EMU_BITS_GET(8, 3, data);
+            uint32_t imm8 = EMU_BITS_GET(0, 8, data);
+            switch (addr)
+            {
+            case ThumbAddr::ThumbInvalid:
+            {
+                break;
+            }
+            case ThumbAddr::ThumbShiftImm:
+            {
+                uint32_t imm = EMU_BITS_GET(6, 5, data);
+                if (!imm && EMU_BITS_GET(11, 2, data))
+                    imm = 32;
+                operands += sprintf(operands, "r%d, r%d, #0x%x", rd, rn, imm);
+                break;
+            }
+            case ThumbAddr::ThumbAddSubReg:
+            {
+                operands += sprintf(operands, "r%d, r%d, r%d", rd, rn, rm);
+                break;
+            }
+            case ThumbAddr::ThumbAddSubImm:
+            {
+                operands += sprintf(operands, "r%d, r%d, #0x%x", rd, rn, rm);
+                break;
+            }
+            case ThumbAddr::ThumbImm8:
+            {
+                operands += sprintf(operands, "r%d, #0x%x", rh, imm8);
+                break;
+            }
+            case ThumbAddr::ThumbAluReg:
+            {
+                operands += sprintf(operands, "r%d, r%d", rd, rn);
+                break;
+            }
+            case ThumbAddr::ThumbHiReg:
+            {
+                rd |= EMU_BIT_GET(7, data) << 3;
+                rn |= EMU_BIT_GET(6, data) << 3;
+                operands += sprintf(operands, "r%d, r%d", rd, rn);
+                break;
+            }
+            case ThumbAddr::ThumbBranchReg:
+            {
+                rn |= EMU_BIT_GET(6, data) << 3;
+                operands += sprintf(operands, "r%d", rn);
+                break;
+            }
+            case ThumbAddr::ThumbLoadPC:
+            {
+                operands += sprintf(operands, "r%d, [pc, #0x%x]", rh, imm8 << 2);
+                break;
+            }
+            case ThumbAddr::ThumbMemReg:
+            {
+                operands += sprintf(operands, "r%d, [r%d, r%d]", rd, rn, rm);
+                break;
+            }
+            case ThumbAddr::ThumbMemImm:
+            {
+                // Word, byte then halfword transfers
+                static const uint32_t shift[] = { 2, 0, 1 };
+                uint32_t imm = EMU_BITS_GET(6, 5, data) << shift[EMU_BITS_GET(12, 4, data) - 6];
+                if (!imm)
+                    operands += sprintf(operands, "r%d, [r%d]", rd, rn);
+                else
+                    operands += sprintf(operands, "r%d, [r%d, #0x%x]", rd, rn, imm);
+                break;
+            }
+            case ThumbAddr::ThumbMemSP:
+            {
+                operands += sprintf(operands, "r%d, [sp, #0x%x]", rh, imm8 << 2);
+                break;
+            }
+            case ThumbAddr::ThumbAddPC:
+            {
+                operands += sprintf(operands, "r%d, pc, #0x%x", rh, imm8 << 2);
+                break;
+            }
+            case ThumbAddr::ThumbAddSP:
+            {
+                operands += sprintf(operands, "r%d, sp, #0x%x", rh, imm8 << 2);
+                break;
+            }
+            case ThumbAddr::ThumbAdjustSP:
+            {
+                operands += sprintf(operands, "sp, #0x%x", EMU_BITS_GET(0, 7, data) << 2);
+                break;
+            }
+            case ThumbAddr::ThumbPushPop:
+            {
+                uint32_t extra = EMU_BIT_GET(11, data) ? 15 : 14;
+                operands = printRegisterList(operands, imm8 | (EMU_BIT_GET(8, data) << extra));
+                break;
+            }
+            case ThumbAddr::ThumbBKPT:
+            case ThumbAddr::ThumbSWI:
+            {
+                operands += sprintf(operands, "#0x%x", imm8);
+                break;
+            }
+            case ThumbAddr::ThumbMemBlock:
+            {
+                operands += sprintf(operands, "r%d!, ", rh);
+                operands = printRegisterList(operands, imm8);
+                break;
+            }
+            case ThumbAddr::ThumbBranchCond:
+            {
+                int32_t offset = static_cast<int32_t>(data << 24) >> 23;
+                operands += sprintf(operands, "#0x%x", pc + 4 + offset);
+                break;
+            }
+            case ThumbAddr::ThumbBranch:
+            {
+                int32_t offset = static_cast<int32_t>(data << 21) >> 20;
+                operands += sprintf(operands, "#0x%x", pc + 4 + offset);
+                break;
+            }
+            case ThumbAddr::ThumbBranchLinkPrefix:
+            {
+                // Shown with the target of the whole pair when the next halfword completes it
+                int32_t offset = static_cast<int32_t>(data << 21) >> 9;
+                uint32_t next = read16(pc + 2);
+                if ((EMU_BITS_GET(13, 3, next) == 0x7) && EMU_BITS_GET(11, 2, next))
+                {
+                    uint32_t label = pc + 4 + offset + (EMU_BITS_GET(0, 11, next) << 1);
+                    if (!EMU_BIT_GET(12, next))
+                        label &= ~0x3;
+                    operands += sprintf(operands, "#0x%x", label);
+                }
+                else
+                    operands += sprintf(operands, "lr, pc, #0x%x", offset);
+                break;
+            }
+            case ThumbAddr::ThumbBranchLinkSuffix:
+            {
+                operands += sprintf(operands, "lr, #0x%x", EMU_BITS_GET(0, 11, data) << 1);
+                break;
+            }
+            default:
+                EMU_ASSERT(false);
+            }
+        }
+
         static const uint8_t insnTable[];
         static const uint8_t addrTable[];
+        static const uint8_t thumbInsnTable[];
+        static const uint8_t thumbAddrTable[];
 
         uint32_t disassembleImpl(char* buffer, size_t size, uint32_t addr, bool thumb)
         {
-            if (thumb)
-            {
-                EMU_INVOKE_ONCE(printf("Thumb not implemented!\n"));
-            }
-
             char instruction[32];
-            char operands[32];
-            char temp[64];
+            char operands[64];
+            char temp[96];
             char* text = temp;
-            disassembleArm(instruction, operands, addr);
+            if (thumb)
+                disassembleThumb(instruction, operands, addr);
+            else
+                disassembleArm(instruction, operands, addr);
             if (operands[0])
                 text += sprintf(text, "%-7s %s", instruction, operands);
             else
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "CpuArm.h"
+#include "CpuArmIr.h"
+#include "CpuArmJit.h"
 
 #pragma warning(push)
 #pragma warning(disable:4127)
@@ -27,27 +29,94 @@ namespace
         return static_cast<T>((value >> bit) & 0x01);
     }
 
-    struct CpuArmInterpreter : public emu::CpuArm
+    // The memory policy is the bus or a statically dispatched memory map deriving from it, the CPU must have been
+    // created with an instance of that type
+    template <typename TMemory>
+    struct CpuArmInterpreterT : public emu::CpuArm
     {
-        // Helpers /////////////////////////////////////////////////////////////
+        // Memory //////////////////////////////////////////////////////////////
 
-#if EMU_CONFIG_LITTLE_ENDIAN
-        static const uint32_t MEM_ACCESS_ENDIAN_8 = 0x00000000;
-        static const uint32_t MEM_ACCESS_ENDIAN_16 = 0x00000000;
-#else
-        static const uint32_t MEM_ACCESS_ENDIAN_8 = 0x00000003;
-        static const uint32_t MEM_ACCESS_ENDIAN_16 = 0x00000002;
-#endif
+        TMemory& getMemory()
+        {
+            return static_cast<TMemory&>(*mMemory);
+        }
+
+        uint8_t read8(uint32_t addr)
+        {
+            idleLoad(addr);
+            mFetchSequential = false;
+            return getMemory().template readTimed<uint8_t>(addr, mAccessCycles, false);
+        }
+
+        uint16_t read16(uint32_t addr)
+        {
+            idleLoad(addr);
+            mFetchSequential = false;
+            return getMemory().template readTimed<uint16_t>(addr & ~0x1, mAccessCycles, false);
+        }
+
+        uint32_t read32(uint32_t addr)
+        {
+            idleLoad(addr);
+            mFetchSequential = false;
+            return getMemory().template readTimed<uint32_t>(addr, mAccessCycles, false);
+        }
+
+        void write8(uint32_t addr, uint8_t value)
+        {
+            idleStore();
+            mFetchSequential = false;
+            getMemory().template writeTimed<uint8_t>(addr, value, mAccessCycles, false);
+        }
+
+        void write16(uint32_t addr, uint16_t value)
+        {
+            idleStore();
+            mFetchSequential = false;
+            getMemory().template writeTimed<uint16_t>(addr & ~0x1, value, mAccessCycles, false);
+        }
+
+        void write32(uint32_t addr, uint32_t value)
+        {
+            idleStore();
+            mFetchSequential = false;
+            getMemory().template writeTimed<uint32_t>(addr, value, mAccessCycles, false);
+        }
+
+        uint16_t fetch16(uint32_t addr)
+        {
+            uint16_t opcode = getMemory().template readTimed<uint16_t>(addr, mAccessCycles, mFetchSequential);
+            mFetchSequential = true;
+            return opcode;
+        }
+
+        uint32_t fetch32(uint32_t addr)
+        {
+            uint32_t opcode = getMemory().template readTimed<uint32_t>(addr, mAccessCycles, mFetchSequential);
+            mFetchSequential = true;
+            return opcode;
+        }
+
+        // Helpers /////////////////////////////////////////////////////////////
 
         bool conditionFlagsPassed()
         {
-            switch (BITS<31, 28>(mOpcode))
+            return conditionPassed(BITS<31, 28>(mOpcode));
+        }
+
+        // Bit i of a mask is set when the condition passes for the packed NZCV value i, NV never passes
+        bool conditionPassed(uint32_t cond)
+        {
+            static const uint16_t conditionMasks[16] =
             {
-            case 0xe: return true;
-            default:
-                EMU_NOT_IMPLEMENTED();
-            }
-            return false;
+                0xf0f0, 0x0f0f, 0xcccc, 0x3333, 0xff00, 0x00ff, 0xaaaa, 0x5555,
+                0x0c0c, 0xf3f3, 0xaa55, 0x55aa, 0x0a05, 0xf5fa, 0xffff, 0x0000,
+            };
+            // AL doesn't read the flags, which may stay pending
+            if (cond == 0xe)
+                return true;
+            resolveFlags();
+            return (conditionMasks[cond] >> getPackedFlags()) & 1;
         }
 
         uint32_t getRegister(uint32_t regIndex)
@@ -60,6 +129,34 @@ namespace
             mRegisters.r[regIndex] = value;
         }
 
+        // Misaligned words are rotated into place
+        uint32_t read32Rotated(uint32_t addr)
+        {
+            return evalRORImm32(read32(addr & ~0x3), (addr & 0x3) << 2);
+        }
+
+        uint32_t addWithFlags(uint32_t a, uint32_t b, uint32_t c)
+        {
+            uint32_t result = a + b + c;
+            setFlagsAdd(a, b, result);
+            return result;
+        }
+
+        // Bit 0 of the target selects the instruction set
+        void branchExchange(uint32_t addr)
+        {
+            if (addr & 1)
+            {
+                mRegisters.cpsr |= EMU_BIT(CPSR_T);
+                branch(addr & ~0x1);
+            }
+            else
+            {
+                mRegisters.cpsr &= ~EMU_BIT(CPSR_T);
+                branch(addr & ~0x3);
+            }
+        }
+
         static uint32_t evalRORImm32(uint32_t imm, uint32_t shift)
         {
             if (!shift)
@@ -71,7 +168,21 @@ namespace
             return result;
         }
 
-        template <uint32_t type>
+        static uint32_t rotateRight(uint32_t value, uint32_t shift)
+        {
+            shift &= 31;
+            return shift ? ((value >> shift) | (value << (32 - shift))) : value;
+        }
+
+        // The carry out is only written when the instruction keeps it, the flags are left untouched otherwise
+        template <bool TSetCarry>
+        void setShifterCarry(uint32_t carry)
+        {
+            if (TSetCarry)
+                setCarry(carry);
+        }
+
+        template <uint32_t type, bool TSetCarry = true>
         uint32_t evalImmShift(uint32_t value, uint32_t shift)
         {
             switch (type)
@@ -79,7 +190,7 @@ namespace
             case 0: // LSL
                 if (shift)
                 {
-                    mRegisters.flag_c = BIT(32 - shift, value);
+                    setShifterCarry<TSetCarry>(BIT(32 - shift, value));
                     return value << (shift & 31);
                 }
                 else
@@ -90,62 +201,84 @@ namespace
             case 1: // LSR
                 if (shift)
                 {
-                    mRegisters.flag_c = BIT(shift - 1, value);
+                    setShifterCarry<TSetCarry>(BIT(shift - 1, value));
                     return static_cast<uint32_t>(value) >> static_cast<uint32_t>(shift);
                 }
                 else
                 {
-                    mRegisters.flag_c = BIT(31, value);
+                    setShifterCarry<TSetCarry>(BIT(31, value));
                     return 0;
                 }
 
             case 2: // ASR
                 if (shift)
                 {
-                    mRegisters.flag_c = BIT(shift - 1, value);
+                    setShifterCarry<TSetCarry>(BIT(shift - 1, value));
                     return static_cast<int32_t>(value) >> static_cast<int32_t>(shift);
                 }
                 else
                 {
-                    mRegisters.flag_c = BIT(31, value);
-                    return -static_cast<int32_t>(mRegisters.flag_c);  // 0 -> 0x00000000, 1 -> 0xffffffff
+                    setShifterCarry<TSetCarry>(BIT(31, value));
+                    return static_cast<int32_t>(value) >> 31;
                 }
 
             case 3: // ROR
                 if (shift)
                 {
-                    mRegisters.flag_c = BIT(shift - 1, value);
-                    return evalRORImm32(value, shift);
+                    setShifterCarry<TSetCarry>(BIT(shift - 1, value));
+                    return rotateRight(value, shift);
                 }
                 else
                 {
-                    mRegisters.flag_c = BIT(0, value);
-                    return (value >> 1) | (mRegisters.flag_c << 31);
+                    // RRX shifts the previous carry in
+                    uint32_t result = (value >> 1) | (getCarry() << 31);
+                    setShifterCarry<TSetCarry>(BIT(0, value));
+                    return result;
                 }
             }
             return 0;
         }
 
-        template <uint32_t type>
+        // Only the low byte of the register counts, a zero amount leaves both the value and the carry unchanged
+        template <uint32_t type, bool TSetCarry = true>
         uint32_t evalRegShift(uint32_t value, uint32_t shift)
         {
+            shift &= 0xff;
+            if (!shift)
+                return value;
+
             switch (type)
             {
             case 0: // LSL
-                mRegisters.flag_c = BIT(32 - shift, value);
-                return value << (shift & 31);
+                if (shift < 32)
+                {
+                    setShifterCarry<TSetCarry>(BIT(32 - shift, value));
+                    return value << shift;
+                }
+                setShifterCarry<TSetCarry>((shift == 32) ? BIT(0, value) : 0);
+                return 0;
 
             case 1: // LSR
-                mRegisters.flag_c = BIT(shift - 1, value);
-                return static_cast<uint32_t>(value) >> static_cast<uint32_t>(shift);
+                if (shift < 32)
+                {
+                    setShifterCarry<TSetCarry>(BIT(shift - 1, value));
+                    return value >> shift;
+                }
+                setShifterCarry<TSetCarry>((shift == 32) ? BIT(31, value) : 0);
+                return 0;
 
             case 2: // ASR
-                mRegisters.flag_c = BIT(shift - 1, value);
-                return static_cast<int32_t>(value) >> static_cast<int32_t>(shift);
+                if (shift < 32)
+                {
+                    setShifterCarry<TSetCarry>(BIT(shift - 1, value));
+                    return static_cast<int32_t>(value) >> static_cast<int32_t>(shift);
+                }
+                setShifterCarry<TSetCarry>(BIT(31, value));
+                return static_cast<int32_t>(value) >> 31;
 
             case 3: // ROR
-                mRegisters.flag_c = BIT(shift - 1, value);
-                return evalRORImm32(value, shift);
+                setShifterCarry<TSetCarry>(BIT((shift - 1) & 31, value));
+                return rotateRight(value, shift);
             }
             return 0;
         }
@@ -159,17 +292,21 @@ namespace
 
         template <uint32_t TKnownBits> void insn_b()
         {
-            EMU_NOT_IMPLEMENTED();
+            if (!conditionFlagsPassed()) return;
+            branch(getRegister(15) + mDecoded->imm);
         }
 
         template <uint32_t TKnownBits> void insn_bl()
         {
-            EMU_NOT_IMPLEMENTED();
+            if (!conditionFlagsPassed()) return;
+            setRegister(14, mPC + 4);
+            branch(getRegister(15) + mDecoded->imm);
         }
 
         template <uint32_t TKnownBits> void insn_bx()
         {
-            EMU_NOT_IMPLEMENTED();
+            if (!conditionFlagsPassed()) return;
+            branchExchange(getRegister(mDecoded->rm));
         }
 
         template <uint32_t TKnownBits> void insn_blx()
@@ -179,7 +316,8 @@ namespace
 
         template <uint32_t TKnownBits> void insn_swi()
         {
-            EMU_NOT_IMPLEMENTED();
+            if (!conditionFlagsPassed()) return;
+            swi(BITS<23, 16>(mOpcode));
         }
 
         template <uint32_t TKnownBits> void insn_bkpt()
@@ -190,43 +328,44 @@ namespace
         template <uint32_t TKnownBits>
         struct ALU
         {
-            CpuArmInterpreter& cpu;
+            CpuArmInterpreterT& cpu;
             uint32_t Rn;
             uint32_t Rd;
             uint32_t Op2;
             bool S;
 
-            ALU(CpuArmInterpreter& _cpu)
+            ALU(CpuArmInterpreterT& _cpu)
                 : cpu(_cpu)
             {
-                uint32_t opcode = cpu.mOpcode;
-                Rn = BITS<19, 16>(opcode);
-                Rd = BITS<15, 12>(opcode);
+                const Decoded& decoded = *cpu.mDecoded;
+                Rd = decoded.rd;
                 S = BIT<20>(TKnownBits);
                 bool I = BIT<25>(TKnownBits);
+                // Only logical operations setting flags keep the shifter carry, arithmetic ones overwrite it
+                constexpr uint32_t Opcode = BITS<24, 21>(TKnownBits);
+                constexpr bool ShifterCarry = BIT<20>(TKnownBits) && ((Opcode < 0x2) || (Opcode == 0x8) || (Opcode == 0x9) || (Opcode >= 0xc));
                 if (I == 0)
                 {
                     constexpr uint32_t ShiftType = BITS<6, 5>(TKnownBits);
-                    uint32_t Rm = BITS<3, 0>(opcode);
                     bool R = BIT<4>(TKnownBits);
                     if (R == 0)
                     {
-                        uint32_t Is = BITS<11, 7>(opcode);
-                        Op2 = cpu.evalImmShift<ShiftType>(cpu.getRegister(Rm), Is);
+                        Op2 = cpu.evalImmShift<ShiftType, ShifterCarry>(cpu.getRegister(decoded.rm), decoded.shift);
                     }
                     else
                     {
-                        uint32_t Rs = BITS<11, 8>(opcode);
-                        cpu.prefetch32();
-                        Op2 = cpu.evalRegShift<ShiftType>(cpu.getRegister(Rm), cpu.getRegister(Rs));
+                        // PC reads one instruction further ahead when the shift amount comes from a register
+                        cpu.mRegisters.r[15] += 4;
+                        Op2 = cpu.evalRegShift<ShiftType, ShifterCarry>(cpu.getRegister(decoded.rm), cpu.getRegister(decoded.rs));
                     }
                 }
                 else
                 {
-                    uint32_t Is = BITS<11, 8>(opcode);
-                    uint32_t Immediate = BITS<7, 0>(opcode);
-                    Op2 = evalRORImm32(Immediate, Is);
+                    Op2 = decoded.imm;
+                    if (ShifterCarry && BITS<11, 8>(decoded.opcode))
+                        cpu.setCarry(BIT<31>(Op2));
                 }
+                Rn = cpu.getRegister(decoded.rn);
             }
 
             void saveResult(uint32_t result)
@@ -241,34 +380,19 @@ namespace
             void saveFlagsLogical(uint32_t result)
             {
                 if (S)
-                {
-                    cpu.mRegisters.flag_n = BIT<31>(result);
-                    cpu.mRegisters.flag_z = result == 0;
-                }
+                    cpu.setFlagsLogical(result);
             }
 
-            void saveFlagsArithmetic(uint32_t result, bool carry, bool overflow)
+            // Subtractions add the complement with a carry in
+            uint32_t add(uint32_t a, uint32_t b, uint32_t c)
             {
+                uint32_t result = a + b + c;
                 if (S)
-                {
-                    cpu.mRegisters.flag_n = BIT<31>(result);
-                    cpu.mRegisters.flag_z = result == 0;
-                    cpu.mRegisters.flag_c = carry;
-                    cpu.mRegisters.flag_v = overflow;
-                }
+                    cpu.setFlagsAdd(a, b, result);
+                return result;
             }
         };
 
-        uint32_t addWithCarry(uint32_t a, uint32_t b, uint32_t c, bool& carry_out, bool& overflow_out)
-        {
-            uint64_t result_unsigned = static_cast<uint64_t>(a) + static_cast<uint64_t>(b) + static_cast<uint64_t>(c);
-            int64_t result_signed = static_cast<int64_t>(static_cast<int32_t>(a)) + static_cast<int64_t>(static_cast<int32_t>(b)) + static_cast<int64_t>(c);
-            uint64_t result = result_unsigned & 0xffffffff;
-            carry_out = result != result_unsigned;
-            overflow_out = static_cast<int64_t>(static_cast<int32_t>(result)) != result_signed;
-            return static_cast<uint32_t>(result);
-        }
-
         template <uint32_t TKnownBits> void insn_and()
         {
             if (!conditionFlagsPassed()) return;
@@ -291,60 +415,48 @@ namespace
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(alu.Rn, ~alu.Op2, 1, carry, overflow);
+            uint32_t result = alu.add(alu.Rn, ~alu.Op2, 1);
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_rsb()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(~alu.Rn, alu.Op2, 1, carry, overflow);
+            uint32_t result = alu.add(~alu.Rn, alu.Op2, 1);
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_add()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(alu.Rn, alu.Op2, 0, carry, overflow);
+            uint32_t result = alu.add(alu.Rn, alu.Op2, 0);
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_adc()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(~alu.Rn, alu.Op2, mRegisters.flag_c, carry, overflow);
+            uint32_t result = alu.add(alu.Rn, alu.Op2, getCarry());
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_sbc()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(alu.Rn, ~alu.Op2, 1, carry, overflow);
+            uint32_t result = alu.add(alu.Rn, ~alu.Op2, getCarry());
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_rsc()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(~alu.Rn, alu.Op2, mRegisters.flag_c, carry, overflow);
+            uint32_t result = alu.add(~alu.Rn, alu.Op2, getCarry());
             alu.saveResult(result);
-            alu.saveFlagsArithmetic(result, carry, overflow);
         }
 
         template <uint32_t TKnownBits> void insn_tst()
@@ -367,18 +479,14 @@ namespace
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(alu.Rn, ~alu.Op2, 1, carry, overflow);
-            alu.saveFlagsArithmetic(result, carry, overflow);
+            alu.add(alu.Rn, ~alu.Op2, 1);
         }
 
         template <uint32_t TKnownBits> void insn_cmn()
         {
             if (!conditionFlagsPassed()) return;
             ALU<TKnownBits> alu(*this);
-            bool carry, overflow;
-            uint32_t result = addWithCarry(alu.Rn, alu.Op2, 0, carry, overflow);
-            alu.saveFlagsArithmetic(result, carry, overflow);
+            alu.add(alu.Rn, alu.Op2, 0);
         }
 
         template <uint32_t TKnownBits> void insn_orr()
@@ -565,11 +673,11 @@ namespace
         template <uint32_t TKnownBits>
         struct MemorySDT
         {
-            MemorySDT(CpuArmInterpreter& cpu)
+            MemorySDT(CpuArmInterpreterT& cpu)
             {
-                uint32_t opcode = cpu.mOpcode;
-                uint32_t Rn = BITS<19, 16>(opcode);
-                uint32_t Rd = BITS<15, 12>(opcode);
+                const Decoded& decoded = *cpu.mDecoded;
+                uint32_t Rn = decoded.rn;
+                uint32_t Rd = decoded.rd;
 
                 bool I = BIT<25>(TKnownBits);
                 bool P = BIT<24>(TKnownBits);
@@ -580,15 +688,15 @@ namespace
                 uint32_t offset;
                 if (I == 0)
                 {
-                    uint32_t Immediate = BITS<11, 0>(opcode);
+                    uint32_t Immediate = decoded.imm;
                     offset = U ? Immediate : (0 - Immediate);
                 }
                 else
                 {
-                    uint32_t Is = BITS<11, 7>(opcode);
+                    // Offset shifts don't change the carry flag
                     constexpr uint32_t ShiftType = BITS<6, 5>(TKnownBits);
-                    uint32_t Rm = BITS<3, 0>(opcode);
-                    offset = cpu.evalImmShift<ShiftType>(cpu.getRegister(Rm), Is);
+                    uint32_t Shifted = cpu.evalImmShift<ShiftType, false>(cpu.getRegister(decoded.rm), decoded.shift);
+                    offset = U ? Shifted : (0 - Shifted);
                 }
 
                 // Pre-increment
@@ -612,18 +720,20 @@ namespace
 
                 // Memory access
                 bool L = BIT<20>(TKnownBits);
+                uint32_t value = 0;
                 if (L == 0)
                 {
                     // Store
+                    value = cpu.getRegister(Rd);
                     if (B)
                     {
                         // STRB
-                        cpu.write8(address ^ MEM_ACCESS_ENDIAN_8, static_cast<uint8_t>(Rd));
+                        cpu.write8(address, static_cast<uint8_t>(value));
                     }
                     else
                     {
                         // STR
-                        cpu.write32(address, Rd);
+                        cpu.write32(address & ~0x3, value);
                     }
                 }
                 else
@@ -632,12 +742,12 @@ namespace
                     if (B)
                     {
                         // LDRB
-                        Rd = static_cast<uint32_t>(cpu.read8(address ^ MEM_ACCESS_ENDIAN_8));
+                        value = static_cast<uint32_t>(cpu.read8(address));
                     }
                     else
                     {
                         // LDR
-                        Rd = cpu.read32(address);
+                        value = cpu.read32Rotated(address);
                     }
                 }
 
@@ -648,39 +758,19 @@ namespace
                     address += offset;
                     cpu.setRegister(Rn, address);
                 }
-            }
 
-            void saveResult(uint32_t result)
-            {
-                if (Rd == 15)
-                {
-                    EMU_NOT_IMPLEMENTED();
-                }
-                cpu.setRegister(Rd, result);
-            }
-
-            void saveFlagsLogical(uint32_t result)
-            {
-                if (S)
+                // Loaded value takes precedence over base register write back
+                if (L == 1)
                 {
-                    cpu.mRegisters.flag_n = BIT<31>(result);
-                    cpu.mRegisters.flag_z = result == 0;
-                }
-            }
-
-            void saveFlagsArithmetic(uint32_t result, bool carry, bool overflow)
-            {
-                if (S)
-                {
-                    cpu.mRegisters.flag_n = BIT<31>(result);
-                    cpu.mRegisters.flag_z = result == 0;
-                    cpu.mRegisters.flag_c = carry;
-                    cpu.mRegisters.flag_v = overflow;
+                    if (Rd == 15)
+                    {
+                        EMU_NOT_IMPLEMENTED();
+                    }
+                    cpu.setRegister(Rd, value);
                 }
             }
         };
 
-
         template <uint32_t TKnownBits> void insn_str()
         {
             if (!conditionFlagsPassed()) return;
@@ -693,6 +783,22 @@ namespace
             MemorySDT<TKnownBits> memory(*this);
         }
 
+        // Tests whose flags are all overwritten before being read
+        void insn_nop()
+        {
+        }
+
+        // PC relative loads folded to the literal read when the block was built, still timed as a data access
+        void insn_ldr_const()
+        {
+            if (!conditionFlagsPassed()) return;
+            bool B = BIT<22>(mDecoded->opcode);
+            idleLoad(mPC);
+            mFetchSequential = false;
+            mAccessCycles += B ? getMemory().getFastPageTiming(mPC).template get<uint8_t>(false) : getMemory().getFastPageTiming(mPC).template get<uint32_t>(false);
+            setRegister(mDecoded->rd, mDecoded->imm);
+        }
+
         template <uint32_t TKnownBits> void insn_stm()
         {
             EMU_NOT_IMPLEMENTED();
@@ -730,6 +836,12 @@ namespace
 
         template <uint32_t TKnownBits> void insn_mcr2()
         {
+            // The ARMv5 tables share the slot with MCR, only the unconditional encoding is MCR2
+            if (BITS<31, 28>(mOpcode) != 0xf)
+            {
+                insn_mcr<TKnownBits>();
+                return;
+            }
             EMU_NOT_IMPLEMENTED();
         }
 
@@ -765,7 +877,9 @@ namespace
 
         template <uint32_t TKnownBits> void insn_mcr()
         {
-            EMU_NOT_IMPLEMENTED();
+            if (!conditionFlagsPassed()) return;
+            uint32_t Rd = BITS<15, 12>(mOpcode);
+            writeCoprocessor(BITS<11, 8>(mOpcode), BITS<23, 21>(mOpcode), BITS<19, 16>(mOpcode), BITS<3, 0>(mOpcode), BITS<7, 5>(mOpcode), getRegister(Rd));
         }
 
         template <uint32_t TKnownBits> void insn_mrc()
@@ -773,20 +887,639 @@ namespace
             EMU_NOT_IMPLEMENTED();
         }
 
+        // Thumb ///////////////////////////////////////////////////////////////
+
+        // Fields within the top 10 bits come from the table index, the others from the decoded opcode
+
+        template <uint32_t TKnownBits> void thumb_invalid()
+        {
+            EMU_NOT_IMPLEMENTED();
+        }
+
+        template <uint32_t TKnownBits> void thumb_lsl_imm()
+        {
+            uint32_t result = evalImmShift<0>(getRegister(mDecoded->rn), BITS<10, 6>(TKnownBits));
+            setRegister(mDecoded->rd, result);
+            setFlagsLogical(result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_lsr_imm()
+        {
+            uint32_t result = evalImmShift<1>(getRegister(mDecoded->rn), BITS<10, 6>(TKnownBits));
+            setRegister(mDecoded->rd, result);
+            setFlagsLogical(result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_asr_imm()
+        {
+            uint32_t result = evalImmShift<2>(getRegister(mDecoded->rn), BITS<10, 6>(TKnownBits));
+            setRegister(mDecoded->rd, result);
+            setFlagsLogical(result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_reg()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rn), getRegister(BITS<8, 6>(TKnownBits)), 0));
+        }
+
+        template <uint32_t TKnownBits> void thumb_sub_reg()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rn), ~getRegister(BITS<8, 6>(TKnownBits)), 1));
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_imm3()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rn), BITS<8, 6>(TKnownBits), 0));
+        }
+
+        template <uint32_t TKnownBits> void thumb_sub_imm3()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rn), ~BITS<8, 6>(TKnownBits), 1));
+        }
+
+        template <uint32_t TKnownBits> void thumb_mov_imm8()
+        {
+            uint32_t result = mDecoded->imm;
+            setRegister(BITS<10, 8>(TKnownBits), result);
+            setFlagsLogical(result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_cmp_imm8()
+        {
+            addWithFlags(getRegister(BITS<10, 8>(TKnownBits)), ~mDecoded->imm, 1);
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_imm8()
+        {
+            constexpr uint32_t Rd = BITS<10, 8>(TKnownBits);
+            setRegister(Rd, addWithFlags(getRegister(Rd), mDecoded->imm, 0));
+        }
+
+        template <uint32_t TKnownBits> void thumb_sub_imm8()
+        {
+            constexpr uint32_t Rd = BITS<10, 8>(TKnownBits);
+            setRegister(Rd, addWithFlags(getRegister(Rd), ~mDecoded->imm, 1));
+        }
+
+        void thumbLogical(uint32_t result)
+        {
+            setRegister(mDecoded->rd, result);
+            setFlagsLogical(result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_and()
+        {
+            thumbLogical(getRegister(mDecoded->rd) & getRegister(mDecoded->rn));
+        }
+
+        template <uint32_t TKnownBits> void thumb_eor()
+        {
+            thumbLogical(getRegister(mDecoded->rd) ^ getRegister(mDecoded->rn));
+        }
+
+        template <uint32_t TKnownBits> void thumb_lsl_reg()
+        {
+            thumbLogical(evalRegShift<0>(getRegister(mDecoded->rd), getRegister(mDecoded->rn)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_lsr_reg()
+        {
+            thumbLogical(evalRegShift<1>(getRegister(mDecoded->rd), getRegister(mDecoded->rn)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_asr_reg()
+        {
+            thumbLogical(evalRegShift<2>(getRegister(mDecoded->rd), getRegister(mDecoded->rn)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_adc()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rd), getRegister(mDecoded->rn), getCarry()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_sbc()
+        {
+            setRegister(mDecoded->rd, addWithFlags(getRegister(mDecoded->rd), ~getRegister(mDecoded->rn), getCarry()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ror()
+        {
+            thumbLogical(evalRegShift<3>(getRegister(mDecoded->rd), getRegister(mDecoded->rn)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_tst()
+        {
+            setFlagsLogical(getRegister(mDecoded->rd) & getRegister(mDecoded->rn));
+        }
+
+        template <uint32_t TKnownBits> void thumb_neg()
+        {
+            setRegister(mDecoded->rd, addWithFlags(0, ~getRegister(mDecoded->rn), 1));
+        }
+
+        template <uint32_t TKnownBits> void thumb_cmp_reg()
+        {
+            addWithFlags(getRegister(mDecoded->rd), ~getRegister(mDecoded->rn), 1);
+        }
+
+        template <uint32_t TKnownBits> void thumb_cmn()
+        {
+            addWithFlags(getRegister(mDecoded->rd), getRegister(mDecoded->rn), 0);
+        }
+
+        template <uint32_t TKnownBits> void thumb_orr()
+        {
+            thumbLogical(getRegister(mDecoded->rd) | getRegister(mDecoded->rn));
+        }
+
+        // The carry is left unchanged, as on ARMv5
+        template <uint32_t TKnownBits> void thumb_mul()
+        {
+            thumbLogical(getRegister(mDecoded->rd) * getRegister(mDecoded->rn));
+        }
+
+        template <uint32_t TKnownBits> void thumb_bic()
+        {
+            thumbLogical(getRegister(mDecoded->rd) & ~getRegister(mDecoded->rn));
+        }
+
+        template <uint32_t TKnownBits> void thumb_mvn()
+        {
+            thumbLogical(~getRegister(mDecoded->rn));
+        }
+
+        // High register operations don't touch the flags, except for CMP. Writing PC stays in Thumb state.
+        template <uint32_t TKnownBits> void thumb_add_hi()
+        {
+            uint32_t Rd = mDecoded->rd | (BIT<7>(TKnownBits) << 3);
+            uint32_t result = getRegister(Rd) + getRegister(mDecoded->rn | (BIT<6>(TKnownBits) << 3));
+            if (Rd == 15)
+                branch(result & ~0x1);
+            else
+                setRegister(Rd, result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_cmp_hi()
+        {
+            uint32_t Rd = mDecoded->rd | (BIT<7>(TKnownBits) << 3);
+            addWithFlags(getRegister(Rd), ~getRegister(mDecoded->rn | (BIT<6>(TKnownBits) << 3)), 1);
+        }
+
+        template <uint32_t TKnownBits> void thumb_mov_hi()
+        {
+            uint32_t Rd = mDecoded->rd | (BIT<7>(TKnownBits) << 3);
+            uint32_t result = getRegister(mDecoded->rn | (BIT<6>(TKnownBits) << 3));
+            if (Rd == 15)
+                branch(result & ~0x1);
+            else
+                setRegister(Rd, result);
+        }
+
+        template <uint32_t TKnownBits> void thumb_bx()
+        {
+            branchExchange(getRegister(mDecoded->rn | (BIT<6>(TKnownBits) << 3)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_blx_reg()
+        {
+            uint32_t addr = getRegister(mDecoded->rn | (BIT<6>(TKnownBits) << 3));
+            setRegister(14, (mPC + 2) | 1);
+            branchExchange(addr);
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldr_pc()
+        {
+            setRegister(BITS<10, 8>(TKnownBits), read32((getRegister(15) & ~0x3) + (mDecoded->imm << 2)));
+        }
+
+        uint32_t thumbRegAddress()
+        {
+            return getRegister(mDecoded->rn) + getRegister(mDecoded->rm);
+        }
+
+        template <uint32_t TKnownBits> void thumb_str_reg()
+        {
+            write32(thumbRegAddress() & ~0x3, getRegister(mDecoded->rd));
+        }
+
+        template <uint32_t TKnownBits> void thumb_strb_reg()
+        {
+            write8(thumbRegAddress(), static_cast<uint8_t>(getRegister(mDecoded->rd)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldr_reg()
+        {
+            setRegister(mDecoded->rd, read32Rotated(thumbRegAddress()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrb_reg()
+        {
+            setRegister(mDecoded->rd, read8(thumbRegAddress()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_strh_reg()
+        {
+            write16(thumbRegAddress(), static_cast<uint16_t>(getRegister(mDecoded->rd)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrsb_reg()
+        {
+            setRegister(mDecoded->rd, static_cast<uint32_t>(static_cast<int8_t>(read8(thumbRegAddress()))));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrh_reg()
+        {
+            setRegister(mDecoded->rd, read16(thumbRegAddress()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrsh_reg()
+        {
+            setRegister(mDecoded->rd, static_cast<uint32_t>(static_cast<int16_t>(read16(thumbRegAddress()))));
+        }
+
+        template <uint32_t TKnownBits, uint32_t Size> uint32_t thumbImmAddress()
+        {
+            return getRegister(mDecoded->rn) + (BITS<10, 6>(TKnownBits) * Size);
+        }
+
+        template <uint32_t TKnownBits> void thumb_str_imm()
+        {
+            write32(thumbImmAddress<TKnownBits, 4>() & ~0x3, getRegister(mDecoded->rd));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldr_imm()
+        {
+            setRegister(mDecoded->rd, read32Rotated(thumbImmAddress<TKnownBits, 4>()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_strb_imm()
+        {
+            write8(thumbImmAddress<TKnownBits, 1>(), static_cast<uint8_t>(getRegister(mDecoded->rd)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrb_imm()
+        {
+            setRegister(mDecoded->rd, read8(thumbImmAddress<TKnownBits, 1>()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_strh_imm()
+        {
+            write16(thumbImmAddress<TKnownBits, 2>(), static_cast<uint16_t>(getRegister(mDecoded->rd)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldrh_imm()
+        {
+            setRegister(mDecoded->rd, read16(thumbImmAddress<TKnownBits, 2>()));
+        }
+
+        template <uint32_t TKnownBits> void thumb_str_sp()
+        {
+            write32((getRegister(13) + (mDecoded->imm << 2)) & ~0x3, getRegister(BITS<10, 8>(TKnownBits)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_ldr_sp()
+        {
+            setRegister(BITS<10, 8>(TKnownBits), read32Rotated(getRegister(13) + (mDecoded->imm << 2)));
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_pc()
+        {
+            setRegister(BITS<10, 8>(TKnownBits), (getRegister(15) & ~0x3) + (mDecoded->imm << 2));
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_sp()
+        {
+            setRegister(BITS<10, 8>(TKnownBits), getRegister(13) + (mDecoded->imm << 2));
+        }
+
+        template <uint32_t TKnownBits> void thumb_add_sp_imm7()
+        {
+            setRegister(13, getRegister(13) + ((mDecoded->imm & 0x7f) << 2));
+        }
+
+        template <uint32_t TKnownBits> void thumb_sub_sp_imm7()
+        {
+            setRegister(13, getRegister(13) - ((mDecoded->imm & 0x7f) << 2));
+        }
+
+        // Lowest registers go to the lowest addresses, the extra register is LR for PUSH and PC for POP
+        template <uint32_t TKnownBits> void thumb_push()
+        {
+            uint32_t list = mDecoded->imm | (BIT<8>(TKnownBits) << 14);
+            uint32_t addr = getRegister(13) - (popcount(list) << 2);
+            setRegister(13, addr);
+            storeList(addr, list);
+        }
+
+        template <uint32_t TKnownBits> void thumb_push_lr()
+        {
+            thumb_push<TKnownBits>();
+        }
+
+        template <uint32_t TKnownBits> void thumb_pop()
+        {
+            setRegister(13, loadList(getRegister(13), mDecoded->imm));
+        }
+
+        template <uint32_t TKnownBits> void thumb_pop_pc()
+        {
+            uint32_t addr = loadList(getRegister(13), mDecoded->imm);
+            setRegister(13, addr + 4);
+            branch(read32(addr) & ~0x1);
+        }
+
+        // ARMv5 pops into PC like BX
+        template <uint32_t TKnownBits> void thumb_pop_pc_bx()
+        {
+            uint32_t addr = loadList(getRegister(13), mDecoded->imm);
+            setRegister(13, addr + 4);
+            branchExchange(read32(addr));
+        }
+
+        template <uint32_t TKnownBits> void thumb_bkpt()
+        {
+            EMU_NOT_IMPLEMENTED();
+        }
+
+        template <uint32_t TKnownBits> void thumb_stmia()
+        {
+            constexpr uint32_t Rb = BITS<10, 8>(TKnownBits);
+            uint32_t addr = getRegister(Rb);
+            storeList(addr, mDecoded->imm);
+            setRegister(Rb, addr + (popcount(mDecoded->imm) << 2));
+        }
+
+        // The loaded value wins when the base register is in the list
+        template <uint32_t TKnownBits> void thumb_ldmia()
+        {
+            constexpr uint32_t Rb = BITS<10, 8>(TKnownBits);
+            uint32_t addr = loadList(getRegister(Rb), mDecoded->imm);
+            if (!BIT(Rb, mDecoded->imm))
+                setRegister(Rb, addr);
+        }
+
+        static uint32_t popcount(uint32_t list)
+        {
+            uint32_t count = 0;
+            for (; list; list &= list - 1)
+                ++count;
+            return count;
+        }
+
+        void storeList(uint32_t addr, uint32_t list)
+        {
+            for (uint32_t index = 0; list; ++index, list >>= 1)
+            {
+                if (list & 1)
+                {
+                    write32(addr & ~0x3, getRegister(index));
+                    addr += 4;
+                }
+            }
+        }
+
+        uint32_t loadList(uint32_t addr, uint32_t list)
+        {
+            for (uint32_t index = 0; list; ++index, list >>= 1)
+            {
+                if (list & 1)
+                {
+                    setRegister(index, read32(addr & ~0x3));
+                    addr += 4;
+                }
+            }
+            return addr;
+        }
+
+        template <uint32_t TKnownBits> void thumb_b_cond()
+        {
+            if (!conditionPassed(BITS<11, 8>(TKnownBits))) return;
+            branch(getRegister(15) + mDecoded->imm);
+        }
+
+        template <uint32_t TKnownBits> void thumb_swi()
+        {
+            swi(mDecoded->imm);
+        }
+
+        template <uint32_t TKnownBits> void thumb_b()
+        {
+            branch(getRegister(15) + mDecoded->imm);
+        }
+
+        // Long branches are split in two halves, the first one leaves the upper part of the offset in LR
+        template <uint32_t TKnownBits> void thumb_bl_prefix()
+        {
+            uint32_t offset = static_cast<uint32_t>(static_cast<int32_t>(mDecoded->imm << 21) >> 9);
+            setRegister(14, getRegister(15) + offset);
+        }
+
+        template <uint32_t TKnownBits> void thumb_bl_suffix()
+        {
+            uint32_t addr = getRegister(14) + (mDecoded->imm << 1);
+            setRegister(14, (mPC + 2) | 1);
+            branch(addr);
+        }
+
+        template <uint32_t TKnownBits> void thumb_blx_suffix()
+        {
+            uint32_t addr = getRegister(14) + (mDecoded->imm << 1);
+            setRegister(14, (mPC + 2) | 1);
+            branchExchange(addr & ~0x3);
+        }
+
         // Interpreter /////////////////////////////////////////////////////////
 
-        typedef void(CpuArmInterpreter::* InterpretedFunction)();
+        typedef void(CpuArmInterpreterT::* InterpretedFunction)();
 
         static const InterpretedFunction insnTable[];
+        static const InterpretedFunction thumbTable[];
+
+        static uint32_t getEntry(uint32_t opcode)
+        {
+            return (EMU_BITS_GET(20, 8, opcode) << 4) | EMU_BITS_GET(4, 4, opcode);
+        }
+
+        static uint32_t getThumbEntry(uint32_t opcode)
+        {
+            return EMU_BITS_GET(6, 10, opcode);
+        }
+
+#if EMU_CONFIG_JIT
+        static uint32_t jitLoadWord(CpuArm* cpu, uint32_t addr)
+        {
+            return static_cast<CpuArmInterpreterT*>(cpu)->read32Rotated(addr);
+        }
+
+        static uint32_t jitLoadByte(CpuArm* cpu, uint32_t addr)
+        {
+            return static_cast<CpuArmInterpreterT*>(cpu)->read8(addr);
+        }
+
+        static void jitStoreWord(CpuArm* cpu, uint32_t addr, uint32_t value)
+        {
+            static_cast<CpuArmInterpreterT*>(cpu)->write32(addr & ~0x3, value);
+        }
+
+        static void jitStoreByte(CpuArm* cpu, uint32_t addr, uint32_t value)
+        {
+            static_cast<CpuArmInterpreterT*>(cpu)->write8(addr, static_cast<uint8_t>(value));
+        }
+
+        static const emu::CpuArmJit::Helpers& getJitHelpers()
+        {
+            static const emu::CpuArmJit::Helpers helpers = { &jitLoadWord, &jitLoadByte, &jitStoreWord, &jitStoreByte };
+            return helpers;
+        }
+#endif
 
         uint32_t interpretImpl()
         {
-            mOpcode = read32(mPC);
-            uint32_t entry = (EMU_BITS_GET(20, 8, mOpcode) << 4) | EMU_BITS_GET(4, 4, mOpcode);
-            (this->*insnTable[entry])();
-            return 1;
+            if (!mBlocks.empty())
+                return interpretBlock();
+            return interpretInstruction();
+        }
+
+        uint32_t interpretInstruction()
+        {
+            mAccessCycles = 0;
+            mDecoded = &mDecodedScratch;
+            if (isThumb())
+            {
+                mOpcode = fetch16(mPC);
+                decodeThumb(mDecodedScratch, mOpcode);
+                (this->*thumbTable[getThumbEntry(mOpcode)])();
+            }
+            else
+            {
+                mOpcode = fetch32(mPC);
+                decode(mDecodedScratch, mOpcode);
+                (this->*insnTable[getEntry(mOpcode)])();
+            }
+            return mAccessCycles;
+        }
+
+        bool buildBlock(Block& block, uint32_t addr, bool thumb)
+        {
+            // Blocks stop at the end of the fast page so that page dirtiness covers all their instructions
+            auto& memory = getMemory();
+            if (!memory.isFastPageReadable(addr))
+                return false;
+            uint32_t pageLimit = (addr | (memory.getFastPageSize() - 1)) + 1;
+            uint32_t count = (pageLimit - addr) >> (thumb ? 1 : 2);
+            if (count > BLOCK_SIZE)
+                count = BLOCK_SIZE;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                auto& decoded = block.insns[index];
+                if (thumb)
+                {
+                    decodeThumb(decoded, memory.read16(addr + (index << 1)));
+                    decoded.handler = static_cast<DecodedHandler>(thumbTable[getThumbEntry(decoded.opcode)]);
+                }
+                else
+                {
+                    decode(decoded, memory.read32(addr + (index << 2)));
+                    decoded.handler = static_cast<DecodedHandler>(insnTable[getEntry(decoded.opcode)]);
+                }
+                decoded.flagsPending = false;
+            }
+            block.addr = addr;
+            block.thumb = thumb;
+            block.count = count;
+            block.timing = &memory.getFastPageTiming(addr);
+            block.code = nullptr;
+            block.codeCount = 0;
+
+            // Thumb blocks lower to an empty IR and are only interpreted
+            emu::CpuArmIr ir;
+            ir.build(block, memory);
+            applyIr(block, ir);
+#if EMU_CONFIG_JIT
+            if (mJit)
+                mJit->compile(block, ir, getJitHelpers());
+#endif
+            return true;
+        }
+
+        // Handlers take the simpler forms found by the IR passes, the opcode keeps its original encoding
+        void applyIr(Block& block, const emu::CpuArmIr& ir)
+        {
+            for (uint32_t index = 0; index < ir.getOpCount(); ++index)
+            {
+                const auto& op = ir.getOp(index);
+                auto& decoded = block.insns[op.index];
+                if (op.kind != emu::CpuArmIr::KIND_COND)
+                    decoded.flagsPending = op.flagsPending;
+                if (op.kind == emu::CpuArmIr::KIND_LOAD_CONST)
+                {
+                    decoded.imm = op.imm;
+                    decoded.handler = static_cast<DecodedHandler>(&CpuArmInterpreterT::insn_ldr_const);
+                }
+                else if ((op.kind == emu::CpuArmIr::KIND_ALU) && EMU_BIT_GET(20, decoded.opcode) && !op.flagsWritten)
+                {
+                    if (emu::CpuArmIr::isTest(op.aluOp))
+                        decoded.handler = static_cast<DecodedHandler>(&CpuArmInterpreterT::insn_nop);
+                    else
+                        decoded.handler = static_cast<DecodedHandler>(insnTable[getEntry(decoded.opcode & ~EMU_BIT(20))]);
+                }
+            }
+        }
+
+        uint32_t interpretBlock()
+        {
+            bool thumb = isThumb();
+            Block* block = findBlock(mPC);
+            if ((block->addr != mPC) || (block->thumb != thumb))
+            {
+                if (!buildBlock(*block, mPC, thumb))
+                {
+                    // Code outside of memory pages is interpreted one instruction at a time
+                    block->addr = BLOCK_INVALID;
+                    return interpretInstruction();
+                }
+            }
+
+            // Leave the block on a taken branch, a state change handled by the caller, or at the end of the slice once
+            // no flag is stale. The caller prefetches after the last executed instruction.
+            uint32_t insnSize = thumb ? 2 : 4;
+            mAccessCycles = 0;
+            const auto& timing = *block->timing;
+            const Decoded* decoded = block->insns;
+            const Decoded* end = decoded + block->count;
+            if (block->code)
+            {
+                // Generated code runs its whole prefix unless a device halts the CPU, and counts every fetch but the
+                // first one. It reads and writes the flags directly.
+                mAccessCycles += timing.get<uint32_t>(mFetchSequential);
+                resolveFlags();
+                block->code(this);
+                decoded += block->codeCount;
+                bool pending = decoded[-1].flagsPending;
+                if ((decoded == end) || (mPCNext != mPC + 4) || mHalted || mIdleLoop || (!pending && (mExecutedCycles + mAccessCycles >= mTargetCycles)))
+                    return mAccessCycles;
+                prefetch32();
+            }
+            for (;;)
+            {
+                mAccessCycles += thumb ? timing.get<uint16_t>(mFetchSequential) : timing.get<uint32_t>(mFetchSequential);
+                mFetchSequential = true;
+                mOpcode = decoded->opcode;
+                mDecoded = decoded;
+                (this->*static_cast<InterpretedFunction>(decoded->handler))();
+                bool pending = decoded->flagsPending;
+                if ((++decoded == end) || (mPCNext != mPC + insnSize) || (isThumb() != thumb) || mHalted || mIdleLoop || (!pending && (mExecutedCycles + mAccessCycles >= mTargetCycles)))
+                    break;
+                if (thumb)
+                    prefetch16();
+                else
+                    prefetch32();
+            }
+            return mAccessCycles;
         }
     };
+
+    typedef CpuArmInterpreterT<emu::MemoryBus32> CpuArmInterpreter;
 }
 
 #pragma warning(pop)
\ No newline at end of file
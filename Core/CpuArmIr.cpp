@@ -0,0 +1,214 @@
+#include "CpuArmIr.h"
+
+namespace emu
+{
+    CpuArmIr::CpuArmIr()
+        : mInsnCount(0)
+        , mOpCount(0)
+    {
+    }
+
+    void CpuArmIr::build(const CpuArm::Block& block, MemoryBus32& memory)
+    {
+        lower(block);
+        foldConstants(block, memory);
+        eliminateDeadFlags();
+        mergeConditions();
+    }
+
+    uint8_t CpuArmIr::getConditionFlags(uint32_t cond)
+    {
+        static const uint8_t flags[16] =
+        {
+            FLAG_Z, FLAG_Z, FLAG_C, FLAG_C, FLAG_N, FLAG_N, FLAG_V, FLAG_V,
+            FLAG_C | FLAG_Z, FLAG_C | FLAG_Z, FLAG_N | FLAG_V, FLAG_N | FLAG_V,
+            FLAG_N | FLAG_Z | FLAG_V, FLAG_N | FLAG_Z | FLAG_V, 0, FLAGS_ALL,
+        };
+        return flags[cond & 0xf];
+    }
+
+    void CpuArmIr::lower(const CpuArm::Block& block)
+    {
+        // Anything not lowered stays with its handler and is assumed to read every flag
+        mInsnCount = block.thumb ? 0 : block.count;
+        for (uint32_t index = 0; index < mInsnCount; ++index)
+        {
+            const auto& decoded = block.insns[index];
+            auto& op = mInsns[index];
+            op = Op();
+            op.kind = KIND_INTERPRET;
+            op.index = static_cast<uint8_t>(index);
+            op.cond = static_cast<uint8_t>(EMU_BITS_GET(28, 4, decoded.opcode));
+            op.flagsRead = FLAGS_ALL;
+            if (op.cond == 0xf)
+                continue;
+
+            switch (EMU_BITS_GET(25, 3, decoded.opcode))
+            {
+            case 0:
+            case 1:
+                lowerAlu(op, decoded);
+                break;
+
+            case 2:
+            case 3:
+                lowerMemory(op, decoded);
+                break;
+
+            case 5:
+                op.kind = KIND_BRANCH;
+                op.link = EMU_BIT_GET(24, decoded.opcode) != 0;
+                op.imm = block.addr + (index << 2) + 8 + decoded.imm;
+                break;
+
+            default:
+                break;
+            }
+            if (op.kind != KIND_INTERPRET)
+                op.flagsRead = getConditionFlags(op.cond);
+        }
+    }
+
+    void CpuArmIr::lowerAlu(Op& op, const CpuArm::Decoded& decoded)
+    {
+        // Register shifts share their encoding space with multiplies and the miscellaneous instructions
+        uint32_t opcode = decoded.opcode;
+        uint32_t aluOp = EMU_BITS_GET(21, 4, opcode);
+        bool I = EMU_BIT_GET(25, opcode) != 0;
+        bool S = EMU_BIT_GET(20, opcode) != 0;
+        uint32_t shiftType = EMU_BITS_GET(5, 2, opcode);
+        if (!I && (EMU_BIT_GET(4, opcode) || (!decoded.shift && shiftType)))
+            return;
+        if ((isTest(aluOp) && !S) || ((aluOp >= 0x5) && (aluOp <= 0x7)))
+            return;
+        if ((decoded.rd == 15) && !isTest(aluOp))
+            return;
+
+        op.kind = KIND_ALU;
+        op.aluOp = static_cast<uint8_t>(aluOp);
+        op.operand = I ? OPERAND_IMM : OPERAND_REG;
+        op.shiftType = static_cast<uint8_t>(shiftType);
+        op.shift = decoded.shift;
+        op.rd = decoded.rd;
+        op.rn = decoded.rn;
+        op.rm = decoded.rm;
+        op.imm = decoded.imm;
+        if (S)
+        {
+            // Logical operations only write the carry when the shifter produces one
+            bool carry = I ? (EMU_BITS_GET(8, 4, opcode) != 0) : (decoded.shift != 0);
+            op.flagsWritten = !isLogical(aluOp) ? FLAGS_ALL : (FLAG_N | FLAG_Z | (carry ? FLAG_C : 0));
+        }
+    }
+
+    void CpuArmIr::lowerMemory(Op& op, const CpuArm::Decoded& decoded)
+    {
+        uint32_t opcode = decoded.opcode;
+        bool I = EMU_BIT_GET(25, opcode) != 0;
+        bool P = EMU_BIT_GET(24, opcode) != 0;
+        bool W = EMU_BIT_GET(21, opcode) != 0;
+        uint32_t shiftType = EMU_BITS_GET(5, 2, opcode);
+        if (I && (EMU_BIT_GET(4, opcode) || (!decoded.shift && shiftType)))
+            return;
+        if ((!P && W) || (decoded.rd == 15))
+            return;
+        if ((!P || W) && ((decoded.rn == 15) || (decoded.rn == decoded.rd)))
+            return;
+
+        op.kind = EMU_BIT_GET(20, opcode) ? KIND_LOAD : KIND_STORE;
+        op.operand = I ? OPERAND_REG : OPERAND_IMM;
+        op.shiftType = static_cast<uint8_t>(shiftType);
+        op.shift = decoded.shift;
+        op.rd = decoded.rd;
+        op.rn = decoded.rn;
+        op.rm = decoded.rm;
+        op.byte = EMU_BIT_GET(22, opcode) != 0;
+        op.preIndexed = P;
+        op.up = EMU_BIT_GET(23, opcode) != 0;
+        op.writeBack = !P || W;
+        op.imm = decoded.imm;
+    }
+
+    void CpuArmIr::foldConstants(const CpuArm::Block& block, MemoryBus32& memory)
+    {
+        // Literals on the block page are covered by its invalidation, unless the block itself may store to them
+        uint32_t pageMask = ~(memory.getFastPageSize() - 1);
+        for (uint32_t index = 0; index < mInsnCount; ++index)
+        {
+            auto& op = mInsns[index];
+            if ((op.kind == KIND_STORE) || (op.kind == KIND_INTERPRET))
+                break;
+            if ((op.kind != KIND_LOAD) || (op.rn != 15) || (op.operand != OPERAND_IMM) || op.writeBack)
+                continue;
+
+            uint32_t addr = block.addr + (index << 2) + 8;
+            addr = op.up ? addr + op.imm : addr - op.imm;
+            if (((addr & pageMask) != (block.addr & pageMask)) || (!op.byte && (addr & 0x3)))
+                continue;
+            op.kind = KIND_LOAD_CONST;
+            op.imm = op.byte ? memory.read8(addr) : memory.read32(addr);
+        }
+    }
+
+    void CpuArmIr::eliminateDeadFlags()
+    {
+        // Every flag is observable once the block exits, at its end, through a branch or on a memory access that
+        // may halt the CPU or synchronize a device. Conditional instructions don't kill the flags they write.
+        uint8_t dropped[CpuArm::BLOCK_SIZE];
+        uint8_t live = FLAGS_ALL;
+        for (uint32_t index = mInsnCount; index-- > 0;)
+        {
+            auto& op = mInsns[index];
+            uint8_t written = op.flagsWritten;
+            dropped[index] = written & ~live;
+            op.flagsWritten &= live;
+            if (op.cond == COND_AL)
+                live &= ~written;
+            bool exits = (op.kind == KIND_BRANCH) || (op.kind == KIND_LOAD) || (op.kind == KIND_STORE);
+            live |= exits ? FLAGS_ALL : op.flagsRead;
+        }
+
+        // The end of a slice can't stop the block until the dropped writes are overwritten
+        uint8_t pending = 0;
+        for (uint32_t index = 0; index < mInsnCount; ++index)
+        {
+            auto& op = mInsns[index];
+            if (op.cond == COND_AL)
+                pending &= ~op.flagsWritten;
+            pending |= dropped[index];
+            op.flagsPending = pending != 0;
+        }
+    }
+
+    void CpuArmIr::mergeConditions()
+    {
+        // A region ends after an instruction writing a flag its condition tests
+        mOpCount = 0;
+        uint32_t index = 0;
+        while (index < mInsnCount)
+        {
+            const auto& insn = mInsns[index];
+            if ((insn.cond == COND_AL) || (insn.kind == KIND_INTERPRET))
+            {
+                mOps[mOpCount++] = insn;
+                ++index;
+                continue;
+            }
+
+            auto& region = mOps[mOpCount++];
+            region = Op();
+            region.kind = KIND_COND;
+            region.index = insn.index;
+            region.cond = insn.cond;
+            region.flagsRead = getConditionFlags(insn.cond);
+            while ((index < mInsnCount) && (mInsns[index].cond == region.cond) && (mInsns[index].kind != KIND_INTERPRET))
+            {
+                const auto& guarded = mInsns[index++];
+                mOps[mOpCount++] = guarded;
+                ++region.count;
+                if ((guarded.flagsWritten & region.flagsRead) || (guarded.kind == KIND_BRANCH))
+                    break;
+            }
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core.h"
+#include "CpuArm.h"
+
+namespace emu
+{
+    // Typed operations lowered from a decoded block, shared by the block interpreter and the JIT. Conditions are
+    // hoisted into regions opened by a KIND_COND operation so a run of instructions tests its condition once.
+    class CpuArmIr
+    {
+    public:
+        static const uint8_t    FLAG_V = 0x1;
+        static const uint8_t    FLAG_C = 0x2;
+        static const uint8_t    FLAG_Z = 0x4;
+        static const uint8_t    FLAG_N = 0x8;
+        static const uint8_t    FLAGS_ALL = 0xf;
+
+        static const uint8_t    COND_AL = 0xe;
+
+        enum Kind : uint8_t
+        {
+            KIND_INTERPRET,     // Left to the instruction handler, which may read or write anything
+            KIND_ALU,
+            KIND_LOAD,
+            KIND_STORE,
+            KIND_LOAD_CONST,    // PC relative load folded to the value found when the block was built
+            KIND_BRANCH,
+            KIND_COND,          // Skips the next count operations unless its condition passes
+        };
+
+        enum Operand : uint8_t
+        {
+            OPERAND_IMM,
+            OPERAND_REG,        // Register shifted by an immediate amount, never RRX nor a 32 bit shift
+        };
+
+        struct Op
+        {
+            Kind        kind;
+            uint8_t     index;          // Instruction of the block, the first one guarded for KIND_COND
+            uint8_t     count;          // Operations guarded by KIND_COND
+            uint8_t     cond;
+            uint8_t     flagsRead;
+            uint8_t     flagsWritten;   // Only the flags a later instruction or the block exit can observe
+            bool        flagsPending;   // Some flags are stale until a later instruction writes them
+            uint8_t     aluOp;
+            Operand     operand;
+            uint8_t     shiftType;
+            uint8_t     shift;
+            uint8_t     rd;
+            uint8_t     rn;
+            uint8_t     rm;
+            bool        byte;
+            bool        preIndexed;
+            bool        up;
+            bool        writeBack;
+            bool        link;
+            uint32_t    imm;            // Immediate operand, branch target or folded constant
+        };
+
+        CpuArmIr();
+        void build(const CpuArm::Block& block, MemoryBus32& memory);
+        static uint8_t getConditionFlags(uint32_t cond);
+
+        static bool isTest(uint32_t aluOp)
+        {
+            return (aluOp >= 0x8) && (aluOp <= 0xb);
+        }
+
+        static bool isLogical(uint32_t aluOp)
+        {
+            return isTest(aluOp) ? !(aluOp & 0x2) : ((aluOp < 0x2) || (aluOp >= 0xc));
+        }
+
+        uint32_t getOpCount() const
+        {
+            return mOpCount;
+        }
+
+        const Op& getOp(uint32_t index) const
+        {
+            return mOps[index];
+        }
+
+    private:
+        static const uint32_t   MAX_OPS = 2 * CpuArm::BLOCK_SIZE;
+
+        void lower(const CpuArm::Block& block);
+        void lowerAlu(Op& op, const CpuArm::Decoded& decoded);
+        void lowerMemory(Op& op, const CpuArm::Decoded& decoded);
+        void foldConstants(const CpuArm::Block& block, MemoryBus32& memory);
+        void eliminateDeadFlags();
+        void mergeConditions();
+
+        Op              mInsns[CpuArm::BLOCK_SIZE];
+        uint32_t        mInsnCount;
+        Op              mOps[MAX_OPS];
+        uint32_t        mOpCount;
+    };
+}
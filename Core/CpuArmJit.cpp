@@ -0,0 +1,1019 @@
+#include "CpuArmJit.h"
+
+#if EMU_CONFIG_JIT
+
+#include <cstring>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    enum HostReg : uint8_t
+    {
+        RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI, R8, R9, R10, R11, R12, R13, R14, R15,
+    };
+
+    enum HostCond : uint8_t
+    {
+        CC_O = 0x0, CC_NO = 0x1, CC_C = 0x2, CC_NC = 0x3, CC_Z = 0x4, CC_NZ = 0x5, CC_A = 0x7, CC_S = 0x8,
+    };
+
+    // Group opcodes selected by the ModRM reg field
+    enum HostGroup : uint8_t
+    {
+        GROUP_ADD = 0, GROUP_OR = 1, GROUP_AND = 4, GROUP_SUB = 5, GROUP_XOR = 6, GROUP_CMP = 7,
+        GROUP_ROR = 1, GROUP_SHL = 4, GROUP_SHR = 5, GROUP_SAR = 7,
+        GROUP_NOT = 2, GROUP_CALL = 2,
+    };
+
+    // Two operand opcodes in their r/m, reg form
+    enum HostOp : uint8_t
+    {
+        OP_ADD = 0x01, OP_OR = 0x09, OP_AND = 0x21, OP_SUB = 0x29, OP_XOR = 0x31, OP_TEST = 0x85, OP_MOV = 0x89,
+    };
+
+    // Minimal x86-64 encoder for what the translator emits, operations are 32 bit unless suffixed with 64
+    class X64Emitter
+    {
+    public:
+        X64Emitter(uint8_t* code)
+            : mPos(code)
+        {
+        }
+
+        uint8_t* getPos() const
+        {
+            return mPos;
+        }
+
+        void op(uint8_t opcode, uint8_t dst, uint8_t src)
+        {
+            rex(false, src, 0, dst);
+            byte(opcode);
+            modrmReg(src, dst);
+        }
+
+        void op64(uint8_t opcode, uint8_t dst, uint8_t src)
+        {
+            rex(true, src, 0, dst);
+            byte(opcode);
+            modrmReg(src, dst);
+        }
+
+        void opImm(uint8_t group, uint8_t dst, uint32_t imm)
+        {
+            rex(false, 0, 0, dst);
+            byte(0x81);
+            modrmReg(group, dst);
+            dword(imm);
+        }
+
+        void opImm64(uint8_t group, uint8_t dst, uint32_t imm)
+        {
+            rex(true, 0, 0, dst);
+            byte(0x81);
+            modrmReg(group, dst);
+            dword(imm);
+        }
+
+        void opMem(uint8_t opcode, uint8_t base, int32_t disp, uint8_t src)
+        {
+            rex(false, src, 0, base);
+            byte(opcode);
+            modrmMem(src, base, disp);
+        }
+
+        void opMemImm(uint8_t group, uint8_t base, int32_t disp, uint32_t imm)
+        {
+            rex(false, 0, 0, base);
+            byte(0x81);
+            modrmMem(group, base, disp);
+            dword(imm);
+        }
+
+        void unary(uint8_t group, uint8_t dst)
+        {
+            rex(false, 0, 0, dst);
+            byte(0xf7);
+            modrmReg(group, dst);
+        }
+
+        void shift(uint8_t group, uint8_t dst, uint8_t count)
+        {
+            rex(false, 0, 0, dst);
+            byte(0xc1);
+            modrmReg(group, dst);
+            byte(count);
+        }
+
+        void shiftCl(uint8_t group, uint8_t dst)
+        {
+            rex(false, 0, 0, dst);
+            byte(0xd3);
+            modrmReg(group, dst);
+        }
+
+        void movImm(uint8_t dst, uint32_t imm)
+        {
+            rex(false, 0, 0, dst);
+            byte(0xb8 + (dst & 7));
+            dword(imm);
+        }
+
+        void movImm64(uint8_t dst, uint64_t imm)
+        {
+            rex(true, 0, 0, dst);
+            byte(0xb8 + (dst & 7));
+            qword(imm);
+        }
+
+        void load(uint8_t dst, uint8_t base, int32_t disp)
+        {
+            rex(false, dst, 0, base);
+            byte(0x8b);
+            modrmMem(dst, base, disp);
+        }
+
+        void load64(uint8_t dst, uint8_t base, int32_t disp)
+        {
+            rex(true, dst, 0, base);
+            byte(0x8b);
+            modrmMem(dst, base, disp);
+        }
+
+        void load8(uint8_t dst, uint8_t base, int32_t disp)
+        {
+            rex(false, dst, 0, base);
+            byte(0x0f);
+            byte(0xb6);
+            modrmMem(dst, base, disp);
+        }
+
+        void store(uint8_t base, int32_t disp, uint8_t src)
+        {
+            opMem(OP_MOV, base, disp, src);
+        }
+
+        void store8(uint8_t base, int32_t disp, uint8_t src)
+        {
+            rex(false, src, 0, base, src >= RSP);
+            byte(0x88);
+            modrmMem(src, base, disp);
+        }
+
+        void storeImm(uint8_t base, int32_t disp, uint32_t imm)
+        {
+            rex(false, 0, 0, base);
+            byte(0xc7);
+            modrmMem(0, base, disp);
+            dword(imm);
+        }
+
+        void storeImm8(uint8_t base, int32_t disp, uint8_t imm)
+        {
+            rex(false, 0, 0, base);
+            byte(0xc6);
+            modrmMem(0, base, disp);
+            byte(imm);
+        }
+
+        void loadIndexed(uint8_t dst, uint8_t base, uint8_t index)
+        {
+            rex(false, dst, index, base);
+            byte(0x8b);
+            modrmIndexed(dst, base, index);
+        }
+
+        void loadIndexed8(uint8_t dst, uint8_t base, uint8_t index)
+        {
+            rex(false, dst, index, base);
+            byte(0x0f);
+            byte(0xb6);
+            modrmIndexed(dst, base, index);
+        }
+
+        void storeIndexed(uint8_t base, uint8_t index, uint8_t src)
+        {
+            rex(false, src, index, base);
+            byte(0x89);
+            modrmIndexed(src, base, index);
+        }
+
+        void storeIndexed8(uint8_t base, uint8_t index, uint8_t src)
+        {
+            rex(false, src, index, base, src >= RSP);
+            byte(0x88);
+            modrmIndexed(src, base, index);
+        }
+
+        void imul64Imm(uint8_t dst, uint8_t src, uint32_t imm)
+        {
+            rex(true, dst, 0, src);
+            byte(0x69);
+            modrmReg(dst, src);
+            dword(imm);
+        }
+
+        void setcc(uint8_t cond, uint8_t dst)
+        {
+            rex(false, 0, 0, dst, dst >= RSP);
+            byte(0x0f);
+            byte(0x90 + cond);
+            modrmReg(0, dst);
+        }
+
+        void push(uint8_t reg)
+        {
+            rex(false, 0, 0, reg);
+            byte(0x50 + (reg & 7));
+        }
+
+        void pop(uint8_t reg)
+        {
+            rex(false, 0, 0, reg);
+            byte(0x58 + (reg & 7));
+        }
+
+        void call(const void* target)
+        {
+            movImm64(RAX, reinterpret_cast<uintptr_t>(target));
+            byte(0xff);
+            modrmReg(GROUP_CALL, RAX);
+        }
+
+        void ret()
+        {
+            byte(0xc3);
+        }
+
+        // Jumps return a label bound once the target is known
+        uint8_t* jcc(uint8_t cond)
+        {
+            byte(0x0f);
+            byte(0x80 + cond);
+            dword(0);
+            return mPos;
+        }
+
+        uint8_t* jmp()
+        {
+            byte(0xe9);
+            dword(0);
+            return mPos;
+        }
+
+        void bind(uint8_t* label)
+        {
+            int32_t rel = static_cast<int32_t>(mPos - label);
+            memcpy(label - 4, &rel, 4);
+        }
+
+    private:
+        void byte(uint8_t value)
+        {
+            *mPos++ = value;
+        }
+
+        void dword(uint32_t value)
+        {
+            memcpy(mPos, &value, 4);
+            mPos += 4;
+        }
+
+        void qword(uint64_t value)
+        {
+            memcpy(mPos, &value, 8);
+            mPos += 8;
+        }
+
+        // Byte registers 4 to 7 need a prefix to mean spl, bpl, sil and dil instead of ah, ch, dh and bh
+        void rex(bool wide, uint8_t reg, uint8_t index, uint8_t base, bool byteReg = false)
+        {
+            uint8_t value = 0x40 | (wide ? 0x08 : 0) | ((reg & 8) >> 1) | ((index & 8) >> 2) | ((base & 8) >> 3);
+            if ((value != 0x40) || byteReg)
+                byte(value);
+        }
+
+        void modrmReg(uint8_t reg, uint8_t rm)
+        {
+            byte(0xc0 | ((reg & 7) << 3) | (rm & 7));
+        }
+
+        void modrmMem(uint8_t reg, uint8_t base, int32_t disp)
+        {
+            byte(0x80 | ((reg & 7) << 3) | (base & 7));
+            if ((base & 7) == RSP)
+                byte(0x24);
+            dword(static_cast<uint32_t>(disp));
+        }
+
+        // A zero displacement byte avoids the special cases of rbp and r13 as base
+        void modrmIndexed(uint8_t reg, uint8_t base, uint8_t index)
+        {
+            byte(0x44 | ((reg & 7) << 3));
+            byte(((index & 7) << 3) | (base & 7));
+            byte(0);
+        }
+
+        uint8_t*    mPos;
+    };
+
+    // Guest registers used the most by a block live in callee saved host registers, r15 holds the CPU
+    const uint8_t   pinnableRegs[] = { RBX, RBP, R12, R13, R14 };
+    const uint8_t   HOST_CPU = R15;
+    const uint8_t   NOT_PINNED = 0xff;
+
+    // Upper bound of the host code for one guest instruction, plus the prologue and epilogue of a block
+    const size_t    MAX_INSN_CODE = 448;
+    const size_t    MAX_BLOCK_OVERHEAD = 192;
+
+    const size_t    CODE_ALIGNMENT = 16;
+}
+
+namespace emu
+{
+    struct CpuArmJit::Translator
+    {
+        typedef CpuArmIr::Op Op;
+
+        Translator(CpuArm& cpu, const CpuArm::Block& block, const CpuArmIr& ir, const Helpers& helpers, uint8_t* code)
+            : mCpu(cpu)
+            , mBlock(block)
+            , mIr(ir)
+            , mHelpers(helpers)
+            , mEmitter(code)
+        {
+            memset(mPinned, NOT_PINNED, sizeof(mPinned));
+        }
+
+        static bool isMemory(const Op& op)
+        {
+            return (op.kind == CpuArmIr::KIND_LOAD) || (op.kind == CpuArmIr::KIND_STORE) || (op.kind == CpuArmIr::KIND_LOAD_CONST);
+        }
+
+        // Operations are translated up to the first one left to the interpreter or to a condition testing several
+        // flags, and stop after a branch. The number of instructions covered is returned in insnCount.
+        static uint32_t getSupportedCount(const CpuArmIr& ir, uint32_t& insnCount)
+        {
+            uint32_t count = 0;
+            insnCount = 0;
+            while (count < ir.getOpCount())
+            {
+                const auto& op = ir.getOp(count);
+                if ((op.kind == CpuArmIr::KIND_INTERPRET) || ((op.kind == CpuArmIr::KIND_COND) && (op.cond > 0x7)))
+                    break;
+                ++count;
+                if (op.kind == CpuArmIr::KIND_COND)
+                    continue;
+                insnCount = op.index + 1u;
+                if (op.kind == CpuArmIr::KIND_BRANCH)
+                    break;
+            }
+            return count;
+        }
+
+        static size_t getMaxCodeSize(uint32_t count)
+        {
+            return MAX_BLOCK_OVERHEAD + count * MAX_INSN_CODE;
+        }
+
+        int32_t getOffset(const void* member) const
+        {
+            return static_cast<int32_t>(reinterpret_cast<const uint8_t*>(member) - reinterpret_cast<const uint8_t*>(&mCpu));
+        }
+
+        int32_t getRegOffset(uint32_t reg) const
+        {
+            return getOffset(&mCpu.mRegisters.r[reg]);
+        }
+
+        uint32_t getPC(const Op& op) const
+        {
+            return mBlock.addr + (static_cast<uint32_t>(op.index) << 2);
+        }
+
+        void pinRegisters(uint32_t count)
+        {
+            uint32_t uses[16] = {};
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const auto& op = mIr.getOp(index);
+                switch (op.kind)
+                {
+                case CpuArmIr::KIND_ALU:
+                    if ((op.aluOp != 0xd) && (op.aluOp != 0xf))
+                        ++uses[op.rn];
+                    if (!CpuArmIr::isTest(op.aluOp))
+                        ++uses[op.rd];
+                    if (op.operand == CpuArmIr::OPERAND_REG)
+                        ++uses[op.rm];
+                    break;
+
+                case CpuArmIr::KIND_LOAD:
+                case CpuArmIr::KIND_STORE:
+                    ++uses[op.rn];
+                    ++uses[op.rd];
+                    if (op.operand == CpuArmIr::OPERAND_REG)
+                        ++uses[op.rm];
+                    break;
+
+                case CpuArmIr::KIND_LOAD_CONST:
+                    ++uses[op.rd];
+                    break;
+
+                default:
+                    break;
+                }
+            }
+
+            // Registers used once are cheaper to access in place than to load and store back
+            uses[15] = 0;
+            for (auto host : pinnableRegs)
+            {
+                uint32_t best = 0;
+                for (uint32_t reg = 1; reg < 15; ++reg)
+                {
+                    if (uses[reg] > uses[best])
+                        best = reg;
+                }
+                if (uses[best] < 2)
+                    break;
+                mPinned[best] = host;
+                uses[best] = 0;
+            }
+        }
+
+        void getGuest(uint8_t host, uint32_t reg, uint32_t pc)
+        {
+            if (reg == 15)
+                mEmitter.movImm(host, pc + 8);
+            else if (mPinned[reg] != NOT_PINNED)
+                mEmitter.op(OP_MOV, host, mPinned[reg]);
+            else
+                mEmitter.load(host, HOST_CPU, getRegOffset(reg));
+        }
+
+        void setGuest(uint32_t reg, uint8_t host)
+        {
+            if (mPinned[reg] != NOT_PINNED)
+                mEmitter.op(OP_MOV, mPinned[reg], host);
+            else
+                mEmitter.store(HOST_CPU, getRegOffset(reg), host);
+        }
+
+        void storeFlag(uint8_t cond, uint8_t& flag)
+        {
+            // Neither setcc nor mov change the host flags, so flags can be stored one after the other
+            mEmitter.setcc(cond, RCX);
+            mEmitter.store8(HOST_CPU, getOffset(&flag), RCX);
+        }
+
+        void prologue()
+        {
+            // Six pushes after the return address leave the stack 16 byte aligned for helper calls once adjusted
+            for (auto host : pinnableRegs)
+                mEmitter.push(host);
+            mEmitter.push(HOST_CPU);
+            mEmitter.opImm64(GROUP_SUB, RSP, 8);
+            mEmitter.op64(OP_MOV, HOST_CPU, RDI);
+            reloadPinned();
+        }
+
+        void epilogue()
+        {
+            mEmitter.opImm64(GROUP_ADD, RSP, 8);
+            mEmitter.pop(HOST_CPU);
+            for (size_t index = sizeof(pinnableRegs); index-- > 0;)
+                mEmitter.pop(pinnableRegs[index]);
+            mEmitter.ret();
+        }
+
+        void spillPinned()
+        {
+            for (uint32_t reg = 0; reg < 15; ++reg)
+            {
+                if (mPinned[reg] != NOT_PINNED)
+                    mEmitter.store(HOST_CPU, getRegOffset(reg), mPinned[reg]);
+            }
+        }
+
+        void reloadPinned()
+        {
+            for (uint32_t reg = 0; reg < 15; ++reg)
+            {
+                if (mPinned[reg] != NOT_PINNED)
+                    mEmitter.load(mPinned[reg], HOST_CPU, getRegOffset(reg));
+            }
+        }
+
+        // Leaves the CPU as the block interpreter would after the last instruction, before the next prefetch
+        void translateExit(uint32_t pc, uint32_t fetchCycles, bool fetchSequential)
+        {
+            spillPinned();
+            if (fetchCycles)
+                mEmitter.opMemImm(GROUP_ADD, HOST_CPU, getOffset(&mCpu.mAccessCycles), fetchCycles);
+            mEmitter.storeImm(HOST_CPU, getOffset(&mCpu.mPC), pc);
+            mEmitter.storeImm(HOST_CPU, getOffset(&mCpu.mPCNext), pc + 4);
+            mEmitter.storeImm(HOST_CPU, getRegOffset(15), pc + 8);
+            if (!mFetchSequentialSet)
+                mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mFetchSequential), fetchSequential ? 1 : 0);
+        }
+
+        // Flags are stored as 0 or 1 bytes, only conditions testing a single flag are translated
+        uint8_t* translateCondition(const Op& op)
+        {
+            auto& registers = mCpu.mRegisters;
+            const uint8_t* flags[] = { &registers.flag_z, &registers.flag_c, &registers.flag_n, &registers.flag_v };
+            static const uint8_t skipConds[] = { CC_Z, CC_NZ };
+            mEmitter.load8(RAX, HOST_CPU, getOffset(flags[op.cond >> 1]));
+            mEmitter.op(OP_TEST, RAX, RAX);
+            return mEmitter.jcc(skipConds[op.cond & 1]);
+        }
+
+        // Loads the second operand in ecx, leaving the shifter carry in dl when requested
+        void translateOperand(const Op& op, uint32_t pc, bool keepCarry)
+        {
+            if (op.operand == CpuArmIr::OPERAND_IMM)
+            {
+                mEmitter.movImm(RCX, op.imm);
+                return;
+            }
+
+            getGuest(RCX, op.rm, pc);
+            if (!op.shift)
+                return;
+
+            static const uint8_t groups[] = { GROUP_SHL, GROUP_SHR, GROUP_SAR, GROUP_ROR };
+            mEmitter.shift(groups[op.shiftType], RCX, op.shift);
+            if (keepCarry)
+                mEmitter.setcc(CC_C, RDX);
+        }
+
+        void translateAlu(const Op& op, uint32_t pc)
+        {
+            // Only the flags still live are stored, logical operations write the carry produced by the shifter
+            uint32_t aluOp = op.aluOp;
+            uint8_t flags = op.flagsWritten;
+            bool shifterCarry = (flags & CpuArmIr::FLAG_C) && CpuArmIr::isLogical(aluOp);
+            translateOperand(op, pc, shifterCarry && (op.operand == CpuArmIr::OPERAND_REG));
+            if ((aluOp != 0xd) && (aluOp != 0xf))
+                getGuest(RAX, op.rn, pc);
+
+            uint8_t carryCond = CC_C;
+            switch (aluOp)
+            {
+            case 0x0: // AND
+            case 0x8: // TST
+                mEmitter.op(OP_AND, RAX, RCX);
+                break;
+
+            case 0x1: // EOR
+            case 0x9: // TEQ
+                mEmitter.op(OP_XOR, RAX, RCX);
+                break;
+
+            case 0x2: // SUB
+            case 0xa: // CMP
+                mEmitter.op(OP_SUB, RAX, RCX);
+                carryCond = CC_NC;
+                break;
+
+            case 0x3: // RSB
+                mEmitter.op(OP_SUB, RCX, RAX);
+                mEmitter.op(OP_MOV, RAX, RCX);
+                carryCond = CC_NC;
+                break;
+
+            case 0x4: // ADD
+            case 0xb: // CMN
+                mEmitter.op(OP_ADD, RAX, RCX);
+                break;
+
+            case 0xc: // ORR
+                mEmitter.op(OP_OR, RAX, RCX);
+                break;
+
+            case 0xd: // MOV
+                mEmitter.op(OP_MOV, RAX, RCX);
+                break;
+
+            case 0xe: // BIC
+                mEmitter.unary(GROUP_NOT, RCX);
+                mEmitter.op(OP_AND, RAX, RCX);
+                break;
+
+            case 0xf: // MVN
+                mEmitter.op(OP_MOV, RAX, RCX);
+                mEmitter.unary(GROUP_NOT, RAX);
+                break;
+            }
+
+            auto& registers = mCpu.mRegisters;
+            if (CpuArmIr::isLogical(aluOp) && (flags & (CpuArmIr::FLAG_N | CpuArmIr::FLAG_Z)))
+                mEmitter.op(OP_TEST, RAX, RAX);
+            if (flags & CpuArmIr::FLAG_N)
+                storeFlag(CC_S, registers.flag_n);
+            if (flags & CpuArmIr::FLAG_Z)
+                storeFlag(CC_Z, registers.flag_z);
+            if (shifterCarry)
+            {
+                if (op.operand == CpuArmIr::OPERAND_REG)
+                {
+                    mEmitter.store8(HOST_CPU, getOffset(&registers.flag_c), RDX);
+                }
+                else
+                {
+                    mEmitter.storeImm8(HOST_CPU, getOffset(&registers.flag_c), static_cast<uint8_t>(EMU_BIT_GET(31, op.imm)));
+                }
+            }
+            else if (flags & CpuArmIr::FLAG_C)
+            {
+                storeFlag(carryCond, registers.flag_c);
+            }
+            if (flags & CpuArmIr::FLAG_V)
+                storeFlag(CC_O, registers.flag_v);
+
+            if (!CpuArmIr::isTest(aluOp))
+                setGuest(op.rd, RAX);
+        }
+
+        // The fast path reads the bus fast page table like MemoryBus::readTimed, anything else calls the interpreter
+        void translateAccess(const Op& op, uint32_t pc, bool load)
+        {
+            bool byte = op.byte;
+            auto& memory = mCpu.getMemoryBus();
+            typedef MemoryBus32::FastPage FastPage;
+
+            mEmitter.op(OP_MOV, RSI, RAX);
+            uint8_t* slowLimit = nullptr;
+            if (memory.getMemLimit() != 0xffffffff)
+            {
+                mEmitter.opImm(GROUP_CMP, RSI, memory.getMemLimit());
+                slowLimit = mEmitter.jcc(CC_A);
+            }
+            mEmitter.op(OP_MOV, RDX, RSI);
+            mEmitter.shift(GROUP_SHR, RDX, static_cast<uint8_t>(memory.getFastPageSizeLog2()));
+            mEmitter.imul64Imm(RDX, RDX, sizeof(FastPage));
+            mEmitter.movImm64(RCX, reinterpret_cast<uintptr_t>(memory.getFastPages()));
+            mEmitter.op64(OP_ADD, RDX, RCX);
+            mEmitter.load64(RCX, RDX, static_cast<int32_t>(load ? offsetof(FastPage, mRead) : offsetof(FastPage, mWrite)));
+            mEmitter.op64(OP_TEST, RCX, RCX);
+            uint8_t* slowPage = mEmitter.jcc(CC_Z);
+
+            // Data accesses are never sequential
+            uint32_t cyclesOffset = MemoryBus32::Timing::getWidthIndex(byte ? 8 : 32) * 2;
+            mEmitter.load64(RDX, RDX, static_cast<int32_t>(offsetof(FastPage, mTiming)));
+            mEmitter.load8(RDX, RDX, static_cast<int32_t>(offsetof(MemoryBus32::Timing, cycles) + cyclesOffset));
+            mEmitter.opMem(OP_ADD, HOST_CPU, getOffset(&mCpu.mAccessCycles), RDX);
+            mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mIdleProbing), 0);
+            if (byte)
+            {
+                if (load)
+                    mEmitter.loadIndexed8(RAX, RCX, RSI);
+                else
+                    mEmitter.storeIndexed8(RCX, RSI, R8);
+            }
+            else
+            {
+                mEmitter.op(OP_MOV, RDI, RSI);
+                mEmitter.opImm(GROUP_AND, RDI, ~0x3u);
+                if (load)
+                {
+                    // Misaligned words are rotated into place
+                    mEmitter.loadIndexed(RAX, RCX, RDI);
+                    mEmitter.op(OP_MOV, RCX, RSI);
+                    mEmitter.opImm(GROUP_AND, RCX, 0x3);
+                    mEmitter.shift(GROUP_SHL, RCX, 3);
+                    mEmitter.shiftCl(GROUP_ROR, RAX);
+                }
+                else
+                {
+                    mEmitter.storeIndexed(RCX, RDI, R8);
+                }
+            }
+            uint8_t* done = mEmitter.jmp();
+
+            // Devices and watches called by the helpers see the guest registers as the interpreter leaves them while
+            // executing the instruction, and may change them
+            if (slowLimit)
+                mEmitter.bind(slowLimit);
+            mEmitter.bind(slowPage);
+            spillPinned();
+            mEmitter.storeImm(HOST_CPU, getOffset(&mCpu.mPC), pc);
+            mEmitter.storeImm(HOST_CPU, getRegOffset(15), pc + 8);
+            mEmitter.op64(OP_MOV, RDI, HOST_CPU);
+            if (load)
+            {
+                mEmitter.call(reinterpret_cast<const void*>(byte ? mHelpers.loadByte : mHelpers.loadWord));
+            }
+            else
+            {
+                mEmitter.op(OP_MOV, RDX, R8);
+                mEmitter.call(reinterpret_cast<const void*>(byte ? mHelpers.storeByte : mHelpers.storeWord));
+            }
+            reloadPinned();
+
+            // A device may have halted the CPU, the block is left after this instruction as the interpreter does
+            mEmitter.load8(RCX, HOST_CPU, getOffset(&mCpu.mHalted));
+            mEmitter.op(OP_TEST, RCX, RCX);
+            uint8_t* running = mEmitter.jcc(CC_Z);
+            if (load)
+                setGuest(op.rd, RAX);
+            translateExit(pc, mFetchCycles, false);
+            if (mFetchSequentialSet)
+                mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mFetchSequential), 0);
+            epilogue();
+            mEmitter.bind(running);
+            mEmitter.bind(done);
+        }
+
+        void translateMemory(const Op& op, uint32_t pc)
+        {
+            translateOperand(op, pc, false);
+            getGuest(RAX, op.rn, pc);
+            bool load = op.kind == CpuArmIr::KIND_LOAD;
+            if (!load)
+                getGuest(R8, op.rd, pc);
+
+            // The base register is written back before the access, the IR rejects bases that are also transferred
+            uint8_t offsetOp = op.up ? OP_ADD : OP_SUB;
+            if (op.preIndexed)
+            {
+                mEmitter.op(offsetOp, RAX, RCX);
+                if (op.writeBack)
+                    setGuest(op.rn, RAX);
+            }
+            else
+            {
+                mEmitter.op(OP_MOV, RDX, RAX);
+                mEmitter.op(offsetOp, RDX, RCX);
+                setGuest(op.rn, RDX);
+            }
+
+            translateAccess(op, pc, load);
+            if (load)
+                setGuest(op.rd, RAX);
+        }
+
+        void translateLoadConst(const Op& op)
+        {
+            // Folded literals still cost the data access on the block page
+            uint32_t cycles = op.byte ? mBlock.timing->get<uint8_t>(false) : mBlock.timing->get<uint32_t>(false);
+            mEmitter.movImm(RAX, op.imm);
+            setGuest(op.rd, RAX);
+            if (cycles)
+                mEmitter.opMemImm(GROUP_ADD, HOST_CPU, getOffset(&mCpu.mAccessCycles), cycles);
+            mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mIdleProbing), 0);
+        }
+
+        void translateBranch(const Op& op)
+        {
+            if (op.link)
+                mEmitter.storeImm(HOST_CPU, getRegOffset(14), getPC(op) + 4);
+            mEmitter.op64(OP_MOV, RDI, HOST_CPU);
+            mEmitter.movImm(RSI, op.imm);
+            mEmitter.call(reinterpret_cast<const void*>(&CpuArmJit::branch));
+        }
+
+        void translate(uint32_t count, uint32_t insnCount)
+        {
+            pinRegisters(count);
+            prologue();
+
+            // Fetch cycles are known once the block is translated assuming every instruction runs, skipped regions
+            // take back the extra cost of the non sequential fetches following their memory accesses. The first
+            // fetch is counted by the interpreter.
+            const auto& timing = *mBlock.timing;
+            uint32_t nonSequential = timing.get<uint32_t>(false);
+            uint32_t sequential = timing.get<uint32_t>(true);
+            uint32_t fetchCycles = 0;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const auto& op = mIr.getOp(index);
+                if ((op.kind != CpuArmIr::KIND_COND) && (op.index + 1u < insnCount))
+                    fetchCycles += isMemory(op) ? nonSequential : sequential;
+            }
+
+            // The fetch state after a conditional memory access is only known at run time
+            const Op* last = nullptr;
+            const Op* lastRegion = nullptr;
+            const Op* region = nullptr;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const auto& op = mIr.getOp(index);
+                if (op.kind == CpuArmIr::KIND_COND)
+                    region = &op;
+                else if ((region != nullptr) && (op.index >= region->index + region->count))
+                    region = nullptr;
+                if (op.kind != CpuArmIr::KIND_COND)
+                {
+                    last = &op;
+                    lastRegion = region;
+                }
+            }
+            bool lastMemory = isMemory(*last);
+            mFetchSequentialSet = lastMemory && (lastRegion != nullptr);
+            uint32_t lastPC = getPC(*last);
+
+            uint8_t* skip = nullptr;
+            uint32_t regionLeft = 0;
+            uint32_t regionCycles = 0;
+            uint8_t* exitLabel = nullptr;
+            bool exited = false;
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                const auto& op = mIr.getOp(index);
+                uint32_t pc = getPC(op);
+                if (op.kind == CpuArmIr::KIND_COND)
+                {
+                    if (mFetchSequentialSet && (&op == lastRegion))
+                        mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mFetchSequential), 1);
+                    skip = translateCondition(op);
+                    regionLeft = op.count;
+                    regionCycles = 0;
+                    continue;
+                }
+
+                switch (op.kind)
+                {
+                case CpuArmIr::KIND_ALU:
+                    translateAlu(op, pc);
+                    break;
+
+                case CpuArmIr::KIND_LOAD:
+                case CpuArmIr::KIND_STORE:
+                    translateMemory(op, pc);
+                    break;
+
+                case CpuArmIr::KIND_LOAD_CONST:
+                    translateLoadConst(op);
+                    break;
+
+                case CpuArmIr::KIND_BRANCH:
+                    // Taken branches leave through their own copy of the exit
+                    translateExit(lastPC, fetchCycles, !lastMemory);
+                    translateBranch(op);
+                    if (regionLeft)
+                        exitLabel = mEmitter.jmp();
+                    else
+                        exited = true;
+                    break;
+
+                default:
+                    EMU_ASSERT(false);
+                    break;
+                }
+
+                if (mFetchSequentialSet && (&op == last))
+                    mEmitter.storeImm8(HOST_CPU, getOffset(&mCpu.mFetchSequential), 0);
+                if (op.index + 1u < insnCount)
+                    mFetchCycles += isMemory(op) ? nonSequential : sequential;
+                if (regionLeft && isMemory(op) && (op.index + 1u < insnCount))
+                    regionCycles += nonSequential - sequential;
+                if (regionLeft && !--regionLeft)
+                {
+                    closeRegion(skip, regionCycles);
+                    skip = nullptr;
+                }
+            }
+            if (skip)
+                closeRegion(skip, regionCycles);
+
+            if (!exited)
+                translateExit(lastPC, fetchCycles, !lastMemory);
+            if (exitLabel)
+                mEmitter.bind(exitLabel);
+            epilogue();
+        }
+
+        void closeRegion(uint8_t* skip, uint32_t cycles)
+        {
+            if (!cycles)
+            {
+                mEmitter.bind(skip);
+                return;
+            }
+            uint8_t* done = mEmitter.jmp();
+            mEmitter.bind(skip);
+            mEmitter.opMemImm(GROUP_SUB, HOST_CPU, getOffset(&mCpu.mAccessCycles), cycles);
+            mEmitter.bind(done);
+        }
+
+        size_t getSize(const uint8_t* code) const
+        {
+            return static_cast<size_t>(mEmitter.getPos() - code);
+        }
+
+        CpuArm&                 mCpu;
+        const CpuArm::Block&    mBlock;
+        const CpuArmIr&         mIr;
+        const Helpers&          mHelpers;
+        X64Emitter              mEmitter;
+        uint8_t                 mPinned[16];
+        bool                    mFetchSequentialSet = false;
+        // Fetch cycles of the instructions translated so far, for exits in the middle of the block
+        uint32_t                mFetchCycles = 0;
+    };
+
+    CpuArmJit::CpuArmJit()
+        : mCpu(nullptr)
+        , mCode(nullptr)
+        , mCodeSize(0)
+        , mCodeUsed(0)
+        , mPageSize(0)
+    {
+    }
+
+    CpuArmJit::~CpuArmJit()
+    {
+        destroy();
+    }
+
+    bool CpuArmJit::create(CpuArm& cpu, size_t codeSize)
+    {
+        destroy();
+        // Pages are never writable and executable at once, compile switches the ones it writes to
+        long pageSize = sysconf(_SC_PAGESIZE);
+        EMU_VERIFY(pageSize > 0);
+        mPageSize = static_cast<size_t>(pageSize);
+        codeSize = (codeSize + mPageSize - 1) & ~(mPageSize - 1);
+        void* code = mmap(nullptr, codeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        EMU_VERIFY(code != MAP_FAILED);
+        mCpu = &cpu;
+        mCode = static_cast<uint8_t*>(code);
+        mCodeSize = codeSize;
+        mCodeUsed = 0;
+        return true;
+    }
+
+    void CpuArmJit::destroy()
+    {
+        if (mCode)
+        {
+            munmap(mCode, mCodeSize);
+            mCode = nullptr;
+        }
+        mCpu = nullptr;
+        mCodeSize = 0;
+        mCodeUsed = 0;
+        mPageSize = 0;
+    }
+
+    void CpuArmJit::compile(CpuArm::Block& block, const CpuArmIr& ir, const Helpers& helpers)
+    {
+        block.code = nullptr;
+        block.codeCount = 0;
+        uint32_t insnCount;
+        uint32_t count = Translator::getSupportedCount(ir, insnCount);
+        if (!insnCount)
+            return;
+
+        size_t maxSize = Translator::getMaxCodeSize(count);
+        if (mCodeUsed + maxSize > mCodeSize)
+            flush(block);
+
+        uint8_t* code = mCode + mCodeUsed;
+        if (!protect(code, maxSize, false))
+            return;
+        Translator translator(*mCpu, block, ir, helpers, code);
+        translator.translate(count, insnCount);
+        size_t size = translator.getSize(code);
+        EMU_ASSERT(size <= maxSize);
+        if (!protect(code, maxSize, true))
+            return;
+        block.code = reinterpret_cast<CpuArm::CompiledFunction>(code);
+        block.codeCount = insnCount;
+        mCodeUsed = (mCodeUsed + size + CODE_ALIGNMENT - 1) & ~(CODE_ALIGNMENT - 1);
+    }
+
+    bool CpuArmJit::protect(uint8_t* code, size_t size, bool executable)
+    {
+        // The pages around the range may hold other blocks, none of them runs while a block is compiled
+        uint8_t* begin = mCode + (static_cast<size_t>(code - mCode) & ~(mPageSize - 1));
+        uint8_t* end = code + size;
+        if (end > mCode + mCodeSize)
+            end = mCode + mCodeSize;
+        int access = executable ? (PROT_READ | PROT_EXEC) : (PROT_READ | PROT_WRITE);
+        return mprotect(begin, static_cast<size_t>(end - begin), access) == 0;
+    }
+
+    void CpuArmJit::branch(CpuArm* cpu, uint32_t addr)
+    {
+        cpu->branch(addr);
+    }
+
+    void CpuArmJit::flush(const CpuArm::Block& keep)
+    {
+        // Other blocks are decoded and translated again the next time they run
+        for (auto& block : mCpu->mBlocks)
+        {
+            if (&block != &keep)
+                block.addr = CpuArm::BLOCK_INVALID;
+            block.code = nullptr;
+            block.codeCount = 0;
+        }
+        mCodeUsed = 0;
+    }
+}
+
+#endif
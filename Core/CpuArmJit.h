@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Core.h"
+#include "CpuArm.h"
+#include "CpuArmIr.h"
+
+#if EMU_CONFIG_JIT
+
+namespace emu
+{
+    // Translates the leading run of supported operations of a cached block IR to x86-64 host code. The block
+    // interpreter runs the generated prefix then interprets whatever follows, so coverage can grow one
+    // instruction class at a time.
+    class CpuArmJit
+    {
+    public:
+        // Slow paths go back through the interpreter specialized for the CPU memory map
+        struct Helpers
+        {
+            uint32_t    (*loadWord)(CpuArm* cpu, uint32_t addr);
+            uint32_t    (*loadByte)(CpuArm* cpu, uint32_t addr);
+            void        (*storeWord)(CpuArm* cpu, uint32_t addr, uint32_t value);
+            void        (*storeByte)(CpuArm* cpu, uint32_t addr, uint32_t value);
+        };
+
+        CpuArmJit();
+        ~CpuArmJit();
+        bool create(CpuArm& cpu, size_t codeSize);
+        void destroy();
+        void compile(CpuArm::Block& block, const CpuArmIr& ir, const Helpers& helpers);
+
+    private:
+        CpuArmJit(const CpuArmJit&) = delete;
+        CpuArmJit& operator=(const CpuArmJit&) = delete;
+
+        struct Translator;
+
+        static void branch(CpuArm* cpu, uint32_t addr);
+        void flush(const CpuArm::Block& keep);
+        bool protect(uint8_t* code, size_t size, bool executable);
+
+        CpuArm*         mCpu;
+        uint8_t*        mCode;
+        size_t          mCodeSize;
+        size_t          mCodeUsed;
+        size_t          mPageSize;
+    };
+}
+
+#endif
@@ -8,7 +8,7 @@ enum class Insn : uint8_t
     blx,
     swi,
     bkpt,
-    and,
+    and_,
     ands,
     eor,
     eors,
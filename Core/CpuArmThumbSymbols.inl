@@ -0,0 +1,69 @@
+// CpuArmThumbSymbols.inl generated automatically
+enum class ThumbInsn : uint8_t
+{
+    invalid,
+    lsl,
+    lsr,
+    asr,
+    add,
+    sub,
+    mov,
+    cmp,
+    and_,
+    eor,
+    adc,
+    sbc,
+    ror,
+    tst,
+    neg,
+    cmn,
+    orr,
+    mul,
+    bic,
+    mvn,
+    bx,
+    blx,
+    ldr,
+    str,
+    strb,
+    ldrb,
+    strh,
+    ldsb,
+    ldrh,
+    ldsh,
+    push,
+    pop,
+    bkpt,
+    stmia,
+    ldmia,
+    b,
+    swi,
+    bl,
+};
+
+enum class ThumbAddr : uint8_t
+{
+    ThumbInvalid,
+    ThumbShiftImm,
+    ThumbAddSubReg,
+    ThumbAddSubImm,
+    ThumbImm8,
+    ThumbAluReg,
+    ThumbHiReg,
+    ThumbBranchReg,
+    ThumbLoadPC,
+    ThumbMemReg,
+    ThumbMemImm,
+    ThumbMemSP,
+    ThumbAddPC,
+    ThumbAddSP,
+    ThumbAdjustSP,
+    ThumbPushPop,
+    ThumbBKPT,
+    ThumbMemBlock,
+    ThumbBranchCond,
+    ThumbSWI,
+    ThumbBranch,
+    ThumbBranchLinkSuffix,
+    ThumbBranchLinkPrefix,
+};
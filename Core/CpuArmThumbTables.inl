@@ -0,0 +1,84 @@
+// CpuArmThumbTables.inl generated automatically
+static const char* ThumbInsnName[] =
+{
+    "???",
+    "lsl",
+    "lsr",
+    "asr",
+    "add",
+    "sub",
+    "mov",
+    "cmp",
+    "and",
+    "eor",
+    "adc",
+    "sbc",
+    "ror",
+    "tst",
+    "neg",
+    "cmn",
+    "orr",
+    "mul",
+    "bic",
+    "mvn",
+    "bx",
+    "blx",
+    "ldr",
+    "str",
+    "strb",
+    "ldrb",
+    "strh",
+    "ldsb",
+    "ldrh",
+    "ldsh",
+    "push",
+    "pop",
+    "bkpt",
+    "stmia",
+    "ldmia",
+    "b",
+    "swi",
+    "bl",
+};
+
+static const char* ThumbInsnSuffix[] =
+{
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+    "",
+};
@@ -1,19 +1,19 @@
 // CpuTablesARM946ES.inl generated automatically
-INSTRUCTION(0x00000000, and,     and,     (ALURegImm<0,0,0,0>))
-INSTRUCTION(0x00000010, and,     and,     (ALURegReg<0,0,0,1>))
-INSTRUCTION(0x00000020, and,     and,     (ALURegImm<0,0,1,0>))
-INSTRUCTION(0x00000030, and,     and,     (ALURegReg<0,0,1,1>))
-INSTRUCTION(0x00000040, and,     and,     (ALURegImm<0,0,2,0>))
-INSTRUCTION(0x00000050, and,     and,     (ALURegReg<0,0,2,1>))
-INSTRUCTION(0x00000060, and,     and,     (ALURegImm<0,0,3,0>))
-INSTRUCTION(0x00000070, and,     and,     (ALURegReg<0,0,3,1>))
-INSTRUCTION(0x00000080, and,     and,     (ALURegImm<0,0,0,0>))
+INSTRUCTION(0x00000000, and,     and_,    (ALURegImm<0,0,0,0>))
+INSTRUCTION(0x00000010, and,     and_,    (ALURegReg<0,0,0,1>))
+INSTRUCTION(0x00000020, and,     and_,    (ALURegImm<0,0,1,0>))
+INSTRUCTION(0x00000030, and,     and_,    (ALURegReg<0,0,1,1>))
+INSTRUCTION(0x00000040, and,     and_,    (ALURegImm<0,0,2,0>))
+INSTRUCTION(0x00000050, and,     and_,    (ALURegReg<0,0,2,1>))
+INSTRUCTION(0x00000060, and,     and_,    (ALURegImm<0,0,3,0>))
+INSTRUCTION(0x00000070, and,     and_,    (ALURegReg<0,0,3,1>))
+INSTRUCTION(0x00000080, and,     and_,    (ALURegImm<0,0,0,0>))
 INSTRUCTION(0x00000090, mul,     mul,     (MulRdRmRs))
-INSTRUCTION(0x000000a0, and,     and,     (ALURegImm<0,0,1,0>))
+INSTRUCTION(0x000000a0, and,     and_,    (ALURegImm<0,0,1,0>))
 INSTRUCTION(0x000000b0, str,     strh,    (MemExReg<0,0,0>))
-INSTRUCTION(0x000000c0, and,     and,     (ALURegImm<0,0,2,0>))
+INSTRUCTION(0x000000c0, and,     and_,    (ALURegImm<0,0,2,0>))
 INSTRUCTION(0x000000d0, ldr,     ldrd,    (MemExReg<0,0,0>))
-INSTRUCTION(0x000000e0, and,     and,     (ALURegImm<0,0,3,0>))
+INSTRUCTION(0x000000e0, and,     and_,    (ALURegImm<0,0,3,0>))
 INSTRUCTION(0x000000f0, str,     strd,    (MemExReg<0,0,0>))
 INSTRUCTION(0x00100000, and,     ands,    (ALURegImm<0,1,0,0>))
 INSTRUCTION(0x00100010, and,     ands,    (ALURegReg<0,1,0,1>))
@@ -511,22 +511,22 @@ INSTRUCTION(0x01f000c0, mvn,     mvns,    (ALURegImm<15,1,2,0>))
 INSTRUCTION(0x01f000d0, ldr,     ldrsb,   (MemExImm<1,1,1>))
 INSTRUCTION(0x01f000e0, mvn,     mvns,    (ALURegImm<15,1,3,0>))
 INSTRUCTION(0x01f000f0, ldr,     ldrsh,   (MemExImm<1,1,1>))
-INSTRUCTION(0x02000000, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000010, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000020, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000030, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000040, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000050, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000060, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000070, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000080, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x02000090, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000a0, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000b0, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000c0, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000d0, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000e0, and,     and,     (ALUImm<0,0>))
-INSTRUCTION(0x020000f0, and,     and,     (ALUImm<0,0>))
+INSTRUCTION(0x02000000, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000010, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000020, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000030, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000040, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000050, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000060, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000070, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000080, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x02000090, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000a0, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000b0, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000c0, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000d0, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000e0, and,     and_,    (ALUImm<0,0>))
+INSTRUCTION(0x020000f0, and,     and_,    (ALUImm<0,0>))
 INSTRUCTION(0x02100000, and,     ands,    (ALUImm<0,1>))
 INSTRUCTION(0x02100010, and,     ands,    (ALUImm<0,1>))
 INSTRUCTION(0x02100020, and,     ands,    (ALUImm<0,1>))
@@ -0,0 +1,1025 @@
+// CpuTablesThumbARM7TDMI.inl generated automatically
+INSTRUCTION(0x0000, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0040, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0080, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x00c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0100, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0140, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0180, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x01c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0200, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0240, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0280, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x02c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0300, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0340, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0380, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x03c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0400, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0440, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0480, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x04c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0500, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0540, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0580, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x05c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0600, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0640, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0680, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x06c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0700, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0740, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0780, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x07c0, lsl_imm,     lsl,     (ThumbShiftImm))
+INSTRUCTION(0x0800, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0840, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0880, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x08c0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0900, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0940, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0980, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x09c0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0a00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0a40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0a80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0ac0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0b00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0b40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0b80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0bc0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0c00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0c40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0c80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0cc0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0d00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0d40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0d80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0dc0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0e00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0e40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0e80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0ec0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0f00, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0f40, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0f80, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x0fc0, lsr_imm,     lsr,     (ThumbShiftImm))
+INSTRUCTION(0x1000, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1040, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1080, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x10c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1100, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1140, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1180, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x11c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1200, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1240, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1280, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x12c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1300, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1340, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1380, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x13c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1400, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1440, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1480, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x14c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1500, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1540, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1580, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x15c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1600, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1640, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1680, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x16c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1700, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1740, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1780, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x17c0, asr_imm,     asr,     (ThumbShiftImm))
+INSTRUCTION(0x1800, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1840, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1880, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x18c0, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1900, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1940, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1980, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x19c0, add_reg,     add,     (ThumbAddSubReg))
+INSTRUCTION(0x1a00, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1a40, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1a80, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1ac0, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1b00, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1b40, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1b80, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1bc0, sub_reg,     sub,     (ThumbAddSubReg))
+INSTRUCTION(0x1c00, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1c40, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1c80, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1cc0, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1d00, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1d40, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1d80, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1dc0, add_imm3,    add,     (ThumbAddSubImm))
+INSTRUCTION(0x1e00, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1e40, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1e80, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1ec0, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1f00, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1f40, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1f80, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x1fc0, sub_imm3,    sub,     (ThumbAddSubImm))
+INSTRUCTION(0x2000, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2040, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2080, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x20c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2100, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2140, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2180, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x21c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2200, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2240, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2280, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x22c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2300, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2340, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2380, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x23c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2400, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2440, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2480, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x24c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2500, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2540, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2580, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x25c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2600, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2640, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2680, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x26c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2700, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2740, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2780, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x27c0, mov_imm8,    mov,     (ThumbImm8))
+INSTRUCTION(0x2800, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2840, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2880, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x28c0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2900, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2940, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2980, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x29c0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2a00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2a40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2a80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2ac0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2b00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2b40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2b80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2bc0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2c00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2c40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2c80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2cc0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2d00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2d40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2d80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2dc0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2e00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2e40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2e80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2ec0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2f00, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2f40, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2f80, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x2fc0, cmp_imm8,    cmp,     (ThumbImm8))
+INSTRUCTION(0x3000, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3040, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3080, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x30c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3100, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3140, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3180, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x31c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3200, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3240, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3280, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x32c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3300, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3340, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3380, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x33c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3400, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3440, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3480, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x34c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3500, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3540, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3580, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x35c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3600, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3640, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3680, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x36c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3700, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3740, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3780, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x37c0, add_imm8,    add,     (ThumbImm8))
+INSTRUCTION(0x3800, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3840, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3880, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x38c0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3900, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3940, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3980, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x39c0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3a00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3a40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3a80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3ac0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3b00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3b40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3b80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3bc0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3c00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3c40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3c80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3cc0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3d00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3d40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3d80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3dc0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3e00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3e40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3e80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3ec0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3f00, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3f40, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3f80, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x3fc0, sub_imm8,    sub,     (ThumbImm8))
+INSTRUCTION(0x4000, and,         and_,    (ThumbAluReg))
+INSTRUCTION(0x4040, eor,         eor,     (ThumbAluReg))
+INSTRUCTION(0x4080, lsl_reg,     lsl,     (ThumbAluReg))
+INSTRUCTION(0x40c0, lsr_reg,     lsr,     (ThumbAluReg))
+INSTRUCTION(0x4100, asr_reg,     asr,     (ThumbAluReg))
+INSTRUCTION(0x4140, adc,         adc,     (ThumbAluReg))
+INSTRUCTION(0x4180, sbc,         sbc,     (ThumbAluReg))
+INSTRUCTION(0x41c0, ror,         ror,     (ThumbAluReg))
+INSTRUCTION(0x4200, tst,         tst,     (ThumbAluReg))
+INSTRUCTION(0x4240, neg,         neg,     (ThumbAluReg))
+INSTRUCTION(0x4280, cmp_reg,     cmp,     (ThumbAluReg))
+INSTRUCTION(0x42c0, cmn,         cmn,     (ThumbAluReg))
+INSTRUCTION(0x4300, orr,         orr,     (ThumbAluReg))
+INSTRUCTION(0x4340, mul,         mul,     (ThumbAluReg))
+INSTRUCTION(0x4380, bic,         bic,     (ThumbAluReg))
+INSTRUCTION(0x43c0, mvn,         mvn,     (ThumbAluReg))
+INSTRUCTION(0x4400, add_hi,      add,     (ThumbHiReg))
+INSTRUCTION(0x4440, add_hi,      add,     (ThumbHiReg))
+INSTRUCTION(0x4480, add_hi,      add,     (ThumbHiReg))
+INSTRUCTION(0x44c0, add_hi,      add,     (ThumbHiReg))
+INSTRUCTION(0x4500, cmp_hi,      cmp,     (ThumbHiReg))
+INSTRUCTION(0x4540, cmp_hi,      cmp,     (ThumbHiReg))
+INSTRUCTION(0x4580, cmp_hi,      cmp,     (ThumbHiReg))
+INSTRUCTION(0x45c0, cmp_hi,      cmp,     (ThumbHiReg))
+INSTRUCTION(0x4600, mov_hi,      mov,     (ThumbHiReg))
+INSTRUCTION(0x4640, mov_hi,      mov,     (ThumbHiReg))
+INSTRUCTION(0x4680, mov_hi,      mov,     (ThumbHiReg))
+INSTRUCTION(0x46c0, mov_hi,      mov,     (ThumbHiReg))
+INSTRUCTION(0x4700, bx,          bx,      (ThumbBranchReg))
+INSTRUCTION(0x4740, bx,          bx,      (ThumbBranchReg))
+INSTRUCTION(0x4780, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0x47c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0x4800, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4840, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4880, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x48c0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4900, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4940, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4980, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x49c0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4a00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4a40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4a80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4ac0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4b00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4b40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4b80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4bc0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4c00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4c40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4c80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4cc0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4d00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4d40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4d80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4dc0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4e00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4e40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4e80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4ec0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4f00, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4f40, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4f80, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x4fc0, ldr_pc,      ldr,     (ThumbLoadPC))
+INSTRUCTION(0x5000, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5040, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5080, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x50c0, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5100, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5140, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5180, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x51c0, str_reg,     str,     (ThumbMemReg))
+INSTRUCTION(0x5200, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5240, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5280, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x52c0, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5300, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5340, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5380, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x53c0, strh_reg,    strh,    (ThumbMemReg))
+INSTRUCTION(0x5400, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5440, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5480, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x54c0, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5500, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5540, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5580, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x55c0, strb_reg,    strb,    (ThumbMemReg))
+INSTRUCTION(0x5600, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5640, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5680, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x56c0, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5700, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5740, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5780, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x57c0, ldrsb_reg,   ldsb,    (ThumbMemReg))
+INSTRUCTION(0x5800, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5840, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5880, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x58c0, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5900, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5940, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5980, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x59c0, ldr_reg,     ldr,     (ThumbMemReg))
+INSTRUCTION(0x5a00, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5a40, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5a80, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5ac0, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5b00, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5b40, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5b80, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5bc0, ldrh_reg,    ldrh,    (ThumbMemReg))
+INSTRUCTION(0x5c00, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5c40, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5c80, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5cc0, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5d00, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5d40, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5d80, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5dc0, ldrb_reg,    ldrb,    (ThumbMemReg))
+INSTRUCTION(0x5e00, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5e40, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5e80, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5ec0, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5f00, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5f40, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5f80, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x5fc0, ldrsh_reg,   ldsh,    (ThumbMemReg))
+INSTRUCTION(0x6000, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6040, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6080, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x60c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6100, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6140, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6180, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x61c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6200, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6240, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6280, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x62c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6300, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6340, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6380, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x63c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6400, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6440, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6480, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x64c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6500, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6540, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6580, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x65c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6600, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6640, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6680, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x66c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6700, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6740, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6780, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x67c0, str_imm,     str,     (ThumbMemImm<4>))
+INSTRUCTION(0x6800, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6840, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6880, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x68c0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6900, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6940, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6980, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x69c0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6a00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6a40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6a80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6ac0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6b00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6b40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6b80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6bc0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6c00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6c40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6c80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6cc0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6d00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6d40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6d80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6dc0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6e00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6e40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6e80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6ec0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6f00, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6f40, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6f80, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x6fc0, ldr_imm,     ldr,     (ThumbMemImm<4>))
+INSTRUCTION(0x7000, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7040, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7080, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x70c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7100, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7140, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7180, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x71c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7200, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7240, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7280, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x72c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7300, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7340, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7380, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x73c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7400, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7440, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7480, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x74c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7500, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7540, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7580, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x75c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7600, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7640, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7680, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x76c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7700, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7740, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7780, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x77c0, strb_imm,    strb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7800, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7840, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7880, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x78c0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7900, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7940, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7980, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x79c0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7a00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7a40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7a80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7ac0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7b00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7b40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7b80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7bc0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7c00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7c40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7c80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7cc0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7d00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7d40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7d80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7dc0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7e00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7e40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7e80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7ec0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7f00, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7f40, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7f80, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x7fc0, ldrb_imm,    ldrb,    (ThumbMemImm<1>))
+INSTRUCTION(0x8000, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8040, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8080, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x80c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8100, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8140, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8180, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x81c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8200, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8240, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8280, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x82c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8300, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8340, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8380, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x83c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8400, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8440, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8480, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x84c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8500, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8540, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8580, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x85c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8600, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8640, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8680, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x86c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8700, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8740, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8780, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x87c0, strh_imm,    strh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8800, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8840, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8880, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x88c0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8900, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8940, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8980, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x89c0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8a00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8a40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8a80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8ac0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8b00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8b40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8b80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8bc0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8c00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8c40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8c80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8cc0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8d00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8d40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8d80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8dc0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8e00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8e40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8e80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8ec0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8f00, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8f40, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8f80, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x8fc0, ldrh_imm,    ldrh,    (ThumbMemImm<2>))
+INSTRUCTION(0x9000, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9040, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9080, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x90c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9100, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9140, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9180, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x91c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9200, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9240, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9280, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x92c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9300, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9340, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9380, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x93c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9400, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9440, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9480, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x94c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9500, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9540, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9580, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x95c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9600, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9640, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9680, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x96c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9700, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9740, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9780, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x97c0, str_sp,      str,     (ThumbMemSP))
+INSTRUCTION(0x9800, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9840, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9880, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x98c0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9900, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9940, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9980, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x99c0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9a00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9a40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9a80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9ac0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9b00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9b40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9b80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9bc0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9c00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9c40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9c80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9cc0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9d00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9d40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9d80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9dc0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9e00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9e40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9e80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9ec0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9f00, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9f40, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9f80, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0x9fc0, ldr_sp,      ldr,     (ThumbMemSP))
+INSTRUCTION(0xa000, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa040, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa080, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa0c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa100, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa140, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa180, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa1c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa200, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa240, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa280, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa2c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa300, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa340, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa380, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa3c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa400, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa440, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa480, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa4c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa500, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa540, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa580, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa5c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa600, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa640, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa680, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa6c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa700, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa740, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa780, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa7c0, add_pc,      add,     (ThumbAddPC))
+INSTRUCTION(0xa800, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa840, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa880, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa8c0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa900, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa940, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa980, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xa9c0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaa00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaa40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaa80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaac0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xab00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xab40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xab80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xabc0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xac00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xac40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xac80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xacc0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xad00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xad40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xad80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xadc0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xae00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xae40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xae80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaec0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaf00, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaf40, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xaf80, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xafc0, add_sp,      add,     (ThumbAddSP))
+INSTRUCTION(0xb000, add_sp_imm7, add,     (ThumbAdjustSP))
+INSTRUCTION(0xb040, add_sp_imm7, add,     (ThumbAdjustSP))
+INSTRUCTION(0xb080, sub_sp_imm7, sub,     (ThumbAdjustSP))
+INSTRUCTION(0xb0c0, sub_sp_imm7, sub,     (ThumbAdjustSP))
+INSTRUCTION(0xb100, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb140, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb180, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb1c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb200, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb240, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb280, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb2c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb300, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb340, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb380, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb3c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb400, push,        push,    (ThumbPushPop))
+INSTRUCTION(0xb440, push,        push,    (ThumbPushPop))
+INSTRUCTION(0xb480, push,        push,    (ThumbPushPop))
+INSTRUCTION(0xb4c0, push,        push,    (ThumbPushPop))
+INSTRUCTION(0xb500, push_lr,     push,    (ThumbPushPop))
+INSTRUCTION(0xb540, push_lr,     push,    (ThumbPushPop))
+INSTRUCTION(0xb580, push_lr,     push,    (ThumbPushPop))
+INSTRUCTION(0xb5c0, push_lr,     push,    (ThumbPushPop))
+INSTRUCTION(0xb600, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb640, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb680, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb6c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb700, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb740, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb780, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb7c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb800, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb840, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb880, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb8c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb900, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb940, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb980, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xb9c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xba00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xba40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xba80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbac0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbb00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbb40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbb80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbbc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbc00, pop,         pop,     (ThumbPushPop))
+INSTRUCTION(0xbc40, pop,         pop,     (ThumbPushPop))
+INSTRUCTION(0xbc80, pop,         pop,     (ThumbPushPop))
+INSTRUCTION(0xbcc0, pop,         pop,     (ThumbPushPop))
+INSTRUCTION(0xbd00, pop_pc,      pop,     (ThumbPushPop))
+INSTRUCTION(0xbd40, pop_pc,      pop,     (ThumbPushPop))
+INSTRUCTION(0xbd80, pop_pc,      pop,     (ThumbPushPop))
+INSTRUCTION(0xbdc0, pop_pc,      pop,     (ThumbPushPop))
+INSTRUCTION(0xbe00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbe40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbe80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbec0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbf00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbf40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbf80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xbfc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xc000, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc040, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc080, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc0c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc100, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc140, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc180, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc1c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc200, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc240, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc280, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc2c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc300, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc340, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc380, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc3c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc400, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc440, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc480, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc4c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc500, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc540, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc580, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc5c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc600, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc640, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc680, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc6c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc700, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc740, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc780, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc7c0, stmia,       stmia,   (ThumbMemBlock))
+INSTRUCTION(0xc800, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc840, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc880, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc8c0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc900, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc940, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc980, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xc9c0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xca00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xca40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xca80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcac0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcb00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcb40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcb80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcbc0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcc00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcc40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcc80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xccc0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcd00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcd40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcd80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcdc0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xce00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xce40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xce80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcec0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcf00, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcf40, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcf80, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xcfc0, ldmia,       ldmia,   (ThumbMemBlock))
+INSTRUCTION(0xd000, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd040, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd080, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd0c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd100, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd140, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd180, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd1c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd200, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd240, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd280, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd2c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd300, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd340, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd380, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd3c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd400, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd440, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd480, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd4c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd500, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd540, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd580, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd5c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd600, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd640, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd680, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd6c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd700, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd740, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd780, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd7c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd800, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd840, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd880, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd8c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd900, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd940, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd980, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xd9c0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xda00, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xda40, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xda80, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdac0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdb00, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdb40, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdb80, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdbc0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdc00, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdc40, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdc80, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdcc0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdd00, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdd40, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xdd80, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xddc0, b_cond,      b,       (ThumbBranchCond))
+INSTRUCTION(0xde00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xde40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xde80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xdec0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xdf00, swi,         swi,     (ThumbSWI))
+INSTRUCTION(0xdf40, swi,         swi,     (ThumbSWI))
+INSTRUCTION(0xdf80, swi,         swi,     (ThumbSWI))
+INSTRUCTION(0xdfc0, swi,         swi,     (ThumbSWI))
+INSTRUCTION(0xe000, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe040, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe080, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe0c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe100, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe140, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe180, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe1c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe200, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe240, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe280, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe2c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe300, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe340, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe380, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe3c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe400, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe440, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe480, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe4c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe500, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe540, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe580, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe5c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe600, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe640, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe680, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe6c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe700, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe740, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe780, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe7c0, b,           b,       (ThumbBranch))
+INSTRUCTION(0xe800, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe840, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe880, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe8c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe900, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe940, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe980, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xe9c0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xea00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xea40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xea80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xeac0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xeb00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xeb40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xeb80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xebc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xec00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xec40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xec80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xecc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xed00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xed40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xed80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xedc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xee00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xee40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xee80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xeec0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xef00, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xef40, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xef80, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xefc0, invalid,     invalid, (ThumbInvalid))
+INSTRUCTION(0xf000, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf040, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf080, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf0c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf100, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf140, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf180, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf1c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf200, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf240, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf280, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf2c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf300, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf340, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf380, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf3c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf400, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf440, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf480, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf4c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf500, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf540, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf580, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf5c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf600, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf640, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf680, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf6c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf700, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf740, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf780, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf7c0, bl_prefix,   bl,      (ThumbBranchLinkPrefix))
+INSTRUCTION(0xf800, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf840, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf880, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf8c0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf900, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf940, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf980, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xf9c0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfa00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfa40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfa80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfac0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfb00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfb40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfb80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfbc0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfc00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfc40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfc80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfcc0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfd00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfd40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfd80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfdc0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfe00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfe40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfe80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xfec0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xff00, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xff40, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xff80, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
+INSTRUCTION(0xffc0, bl_suffix,   bl,      (ThumbBranchLinkSuffix))
@@ -19,7 +19,7 @@ namespace emu
             mFunc = [](void*, TArgs...)->TRet { return TRet(); };
         }
 
-        template <typename TRet(*TFunction)(TArgs...)>
+        template <TRet(*TFunction)(TArgs...)>
         void bind()
         {
             mInstance = nullptr;
@@ -39,7 +39,7 @@ namespace emu
             };
         }
 
-        template <typename TRet(*TFunction)(TArgs...)>
+        template <TRet(*TFunction)(TArgs...)>
         static Delegate<TRet(TArgs...)> make()
         {
             Delegate<TRet(TArgs...)> item;
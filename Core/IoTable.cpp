@@ -0,0 +1,14 @@
+#include "IoTable.h"
+
+namespace emu
+{
+    void ioUnmappedRead(const char* name, uint32_t addr, uint32_t size)
+    {
+        printf("%s: unmapped %d-bit read at address 0x%08x\n", name, static_cast<int>(8 * size), addr);
+    }
+
+    void ioUnmappedWrite(const char* name, uint32_t addr, uint32_t size, uint32_t value)
+    {
+        printf("%s: unmapped %d-bit write at address 0x%08x (value = 0x%08x)\n", name, static_cast<int>(8 * size), addr, value);
+    }
+}
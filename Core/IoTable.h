@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Core.h"
+#include "MemoryBus.h"
+#include <vector>
+
+namespace emu
+{
+    void ioUnmappedRead(const char* name, uint32_t addr, uint32_t size);
+    void ioUnmappedWrite(const char* name, uint32_t addr, uint32_t size, uint32_t value);
+
+    template <typename TOwner>
+    class IoTableT
+    {
+    public:
+        typedef uint32_t(*ReadFunc)(TOwner& owner);
+        typedef void(*WriteFunc)(TOwner& owner, uint32_t value, uint32_t mask);
+
+        struct Register
+        {
+            const char*     name;
+            uint32_t        addr;
+            uint32_t        size;
+            ReadFunc        read;
+            WriteFunc       write;
+        };
+
+        // Handlers always see the whole register, narrower accesses are shifted into place and masked
+        template <uint32_t(TOwner::*TFunction)()>
+        static uint32_t makeRead(TOwner& owner)
+        {
+            return (owner.*TFunction)();
+        }
+
+        template <void(TOwner::*TFunction)(uint32_t, uint32_t)>
+        static void makeWrite(TOwner& owner, uint32_t value, uint32_t mask)
+        {
+            (owner.*TFunction)(value, mask);
+        }
+
+        bool create(const char* name, TOwner& owner, uint32_t base, uint32_t size, const Register* registers, size_t count)
+        {
+            EMU_VERIFY(count < 0xffff);
+
+            mName = name;
+            mOwner = &owner;
+            mBase = base;
+            mSize = size;
+
+            // Index 0 is the shared entry for every unmapped byte
+            Register unmapped = { "unmapped", 0, 0, nullptr, nullptr };
+            mRegisters.assign(1, unmapped);
+            mRegisters.insert(mRegisters.end(), registers, registers + count);
+            mIndices.assign(size, 0);
+            for (size_t index = 1; index < mRegisters.size(); ++index)
+            {
+                const auto& reg = mRegisters[index];
+                EMU_VERIFY((reg.size == 1) || (reg.size == 2) || (reg.size == 4));
+                EMU_VERIFY((reg.addr & (reg.size - 1)) == 0);
+                EMU_VERIFY((reg.addr >= base) && (reg.addr - base + reg.size <= size));
+                for (uint32_t offset = reg.addr - base; offset < reg.addr - base + reg.size; ++offset)
+                {
+                    EMU_VERIFY(mIndices[offset] == 0);
+                    mIndices[offset] = static_cast<uint16_t>(index);
+                }
+            }
+            return true;
+        }
+
+        void bind(MemoryBus32::Accessor& accessor)
+        {
+            accessor.setName(mName)
+                .setReadFunc(MemoryBus32::ReadDelegate8::template make<IoTableT, &IoTableT::template read<uint8_t>>(this))
+                .setReadFunc(MemoryBus32::ReadDelegate16::template make<IoTableT, &IoTableT::template read<uint16_t>>(this))
+                .setReadFunc(MemoryBus32::ReadDelegate32::template make<IoTableT, &IoTableT::template read<uint32_t>>(this))
+                .setWriteFunc(MemoryBus32::WriteDelegate8::template make<IoTableT, &IoTableT::template write<uint8_t>>(this))
+                .setWriteFunc(MemoryBus32::WriteDelegate16::template make<IoTableT, &IoTableT::template write<uint16_t>>(this))
+                .setWriteFunc(MemoryBus32::WriteDelegate32::template make<IoTableT, &IoTableT::template write<uint32_t>>(this));
+        }
+
+        template <typename T>
+        T read(uint32_t addr)
+        {
+            uint32_t offset = addr - mBase;
+            if (offset < mSize)
+            {
+                const auto& reg = mRegisters[mIndices[offset]];
+                uint32_t shift = addr - reg.addr;
+                if (reg.read && (shift + sizeof(T) <= reg.size))
+                    return static_cast<T>(reg.read(*mOwner) >> (8 * shift));
+            }
+            return static_cast<T>(readSplit(addr, sizeof(T)));
+        }
+
+        template <typename T>
+        void write(uint32_t addr, T value)
+        {
+            uint32_t offset = addr - mBase;
+            if (offset < mSize)
+            {
+                const auto& reg = mRegisters[mIndices[offset]];
+                uint32_t shift = addr - reg.addr;
+                if (reg.write && (shift + sizeof(T) <= reg.size))
+                    return reg.write(*mOwner, static_cast<uint32_t>(value) << (8 * shift), getMask(sizeof(T)) << (8 * shift));
+            }
+            writeSplit(addr, value, sizeof(T));
+        }
+
+    private:
+        static uint32_t getMask(uint32_t size)
+        {
+            return (size >= 4) ? ~0u : ((1u << (8 * size)) - 1);
+        }
+
+        uint32_t readSplit(uint32_t addr, uint32_t size)
+        {
+            // Accesses straddling registers or touching unmapped bytes are assembled one register at a time
+            uint32_t value = 0;
+            bool unmapped = false;
+            for (uint32_t pos = 0; pos < size;)
+            {
+                uint32_t offset = addr + pos - mBase;
+                const auto& reg = (offset < mSize) ? mRegisters[mIndices[offset]] : mRegisters[0];
+                if (!reg.read)
+                {
+                    unmapped = true;
+                    ++pos;
+                    continue;
+                }
+                uint32_t shift = addr + pos - reg.addr;
+                uint32_t count = std::min(reg.size - shift, size - pos);
+                value |= ((reg.read(*mOwner) >> (8 * shift)) & getMask(count)) << (8 * pos);
+                pos += count;
+            }
+            if (unmapped)
+                ioUnmappedRead(mName, addr, size);
+            return value;
+        }
+
+        void writeSplit(uint32_t addr, uint32_t value, uint32_t size)
+        {
+            bool unmapped = false;
+            for (uint32_t pos = 0; pos < size;)
+            {
+                uint32_t offset = addr + pos - mBase;
+                const auto& reg = (offset < mSize) ? mRegisters[mIndices[offset]] : mRegisters[0];
+                if (!reg.write)
+                {
+                    unmapped = true;
+                    ++pos;
+                    continue;
+                }
+                uint32_t shift = addr + pos - reg.addr;
+                uint32_t count = std::min(reg.size - shift, size - pos);
+                uint32_t bits = (value >> (8 * pos)) & getMask(count);
+                reg.write(*mOwner, bits << (8 * shift), getMask(count) << (8 * shift));
+                pos += count;
+            }
+            if (unmapped)
+                ioUnmappedWrite(mName, addr, size, value);
+        }
+
+        const char*             mName{ "" };
+        TOwner*                 mOwner{ nullptr };
+        uint32_t                mBase{ 0 };
+        uint32_t                mSize{ 0 };
+        std::vector<Register>   mRegisters;
+        std::vector<uint16_t>   mIndices;
+    };
+}
@@ -2,6 +2,11 @@
 
 #include "Core.h"
 #include "Delegate.h"
+#include "MemoryStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
 #include <vector>
 
 namespace emu
@@ -10,69 +15,200 @@ namespace emu
     class MemoryBusT
     {
     public:
-        typedef typename TAddrType AddrType;
-        typedef typename TDataType DataType;
+        typedef TAddrType AddrType;
+        typedef TDataType DataType;
 
+        typedef Delegate<uint8_t(AddrType)>         ReadDelegate8;
+        typedef Delegate<uint16_t(AddrType)>        ReadDelegate16;
+        typedef Delegate<uint32_t(AddrType)>        ReadDelegate32;
         typedef Delegate<DataType(AddrType)>        ReadDelegate;
+        typedef Delegate<void(AddrType, uint8_t)>   WriteDelegate8;
+        typedef Delegate<void(AddrType, uint16_t)>  WriteDelegate16;
+        typedef Delegate<void(AddrType, uint32_t)>  WriteDelegate32;
         typedef Delegate<void(AddrType, DataType)>  WriteDelegate;
+        typedef Delegate<void(AddrType addr, DataType value, uint32_t size, bool write)> WatchDelegate;
+
+        struct Timing
+        {
+            // Access cost in cycles, indexed by access width (8, 16, 32) then by non sequential / sequential
+            uint8_t             cycles[3][2];
+
+            Timing& set(uint32_t width, uint8_t nonSequential, uint8_t sequential)
+            {
+                cycles[getWidthIndex(width)][0] = nonSequential;
+                cycles[getWidthIndex(width)][1] = sequential;
+                return *this;
+            }
+
+            template <typename T>
+            uint32_t get(bool sequential) const
+            {
+                return cycles[sizeof(T) >> 1][sequential ? 1 : 0];
+            }
+
+            static uint32_t getWidthIndex(uint32_t width)
+            {
+                EMU_ASSERT((width == 8) || (width == 16) || (width == 32));
+                return width >> 4;
+            }
+        };
+
+        class DirtyTracker;
 
         struct Accessor
         {
             Accessor& setName(const char* value)
             {
                 name = value;
+                EMU_MEMORY_STATS(statsIndex = MemoryStats::registerAccessor(name));
+                return *this;
+            }
+
+            Accessor& setTiming(uint32_t width, uint8_t nonSequential, uint8_t sequential)
+            {
+                timing.set(width, nonSequential, sequential);
                 return *this;
             }
 
             Accessor& setMemoryWritable(void* value)
             {
                 readMemory = static_cast<const uint8_t*>(value);
-                readFunc = ReadDelegate::make<invalidRead>();
+                resetReadFuncs();
                 writeMemory = static_cast<uint8_t*>(value);
-                writeFunc = WriteDelegate::make<invalidWrite>();
+                resetWriteFuncs();
                 return *this;
             }
 
             Accessor& setMemoryReadOnly(const void* value)
             {
                 readMemory = static_cast<const uint8_t*>(value);
-                readFunc = ReadDelegate::make<invalidRead>();
+                resetReadFuncs();
                 writeMemory = nullptr;
                 return *this;
             }
 
-            Accessor& setReadFunc(ReadDelegate value)
+            // Memory shared by several buses or mapped through mirrors tracks its dirty pages here instead of per bus
+            Accessor& setDirtyTracker(DirtyTracker& value)
+            {
+                dirtyTracker = &value;
+                return *this;
+            }
+
+            Accessor& setReadFunc(ReadDelegate8 value)
+            {
+                readMemory = nullptr;
+                readFunc8 = value;
+                return *this;
+            }
+
+            Accessor& setReadFunc(ReadDelegate16 value)
+            {
+                readMemory = nullptr;
+                readFunc16 = value;
+                return *this;
+            }
+
+            Accessor& setReadFunc(ReadDelegate32 value)
             {
                 readMemory = nullptr;
-                readFunc = value;
+                readFunc32 = value;
                 return *this;
             }
 
-            Accessor& setWriteFunc(WriteDelegate value)
+            Accessor& setWriteFunc(WriteDelegate8 value)
             {
                 writeMemory = nullptr;
-                writeFunc = value;
+                writeFunc8 = value;
                 return *this;
             }
 
-            static DataType invalidRead(AddrType addr)
+            Accessor& setWriteFunc(WriteDelegate16 value)
+            {
+                writeMemory = nullptr;
+                writeFunc16 = value;
+                return *this;
+            }
+
+            Accessor& setWriteFunc(WriteDelegate32 value)
+            {
+                writeMemory = nullptr;
+                writeFunc32 = value;
+                return *this;
+            }
+
+            uint8_t callRead(AddrType addr, uint8_t)
+            {
+                return readFunc8(addr);
+            }
+
+            uint16_t callRead(AddrType addr, uint16_t)
+            {
+                return readFunc16(addr);
+            }
+
+            uint32_t callRead(AddrType addr, uint32_t)
+            {
+                return readFunc32(addr);
+            }
+
+            void callWrite(AddrType addr, uint8_t value)
+            {
+                writeFunc8(addr, value);
+            }
+
+            void callWrite(AddrType addr, uint16_t value)
+            {
+                writeFunc16(addr, value);
+            }
+
+            void callWrite(AddrType addr, uint32_t value)
+            {
+                writeFunc32(addr, value);
+            }
+
+            void resetReadFuncs()
+            {
+                readFunc8 = ReadDelegate8::template make<invalidRead<uint8_t>>();
+                readFunc16 = ReadDelegate16::template make<invalidRead<uint16_t>>();
+                readFunc32 = ReadDelegate32::template make<invalidRead<uint32_t>>();
+            }
+
+            void resetWriteFuncs()
             {
-                printf("Invalid read access at address 0x%08x\n", addr);
+                writeFunc8 = WriteDelegate8::template make<invalidWrite<uint8_t>>();
+                writeFunc16 = WriteDelegate16::template make<invalidWrite<uint16_t>>();
+                writeFunc32 = WriteDelegate32::template make<invalidWrite<uint32_t>>();
+            }
+
+            template <typename T>
+            static T invalidRead(AddrType addr)
+            {
+                printf("Invalid %d-bit read access at address 0x%08x\n", static_cast<int>(8 * sizeof(T)), addr);
                 EMU_ASSERT(false);
                 return 0;
             }
 
-            static void invalidWrite(AddrType addr, DataType value)
+            template <typename T>
+            static void invalidWrite(AddrType addr, T value)
             {
-                printf("Invalid write access at address 0x%08x (value = 0x%08x)\n", addr, value);
+                printf("Invalid %d-bit write access at address 0x%08x (value = 0x%08x)\n", static_cast<int>(8 * sizeof(T)), addr, value);
                 EMU_ASSERT(false);
             }
 
             std::string         name;
             const uint8_t*      readMemory{ nullptr };
-            ReadDelegate        readFunc{ ReadDelegate::make<invalidRead>() };
+            ReadDelegate8       readFunc8{ ReadDelegate8::template make<invalidRead<uint8_t>>() };
+            ReadDelegate16      readFunc16{ ReadDelegate16::template make<invalidRead<uint16_t>>() };
+            ReadDelegate32      readFunc32{ ReadDelegate32::template make<invalidRead<uint32_t>>() };
             uint8_t*            writeMemory{ nullptr };
-            WriteDelegate       writeFunc{ WriteDelegate::make<invalidWrite>() };
+            WriteDelegate8      writeFunc8{ WriteDelegate8::template make<invalidWrite<uint8_t>>() };
+            WriteDelegate16     writeFunc16{ WriteDelegate16::template make<invalidWrite<uint16_t>>() };
+            WriteDelegate32     writeFunc32{ WriteDelegate32::template make<invalidWrite<uint32_t>>() };
+            Timing              timing{ { { 1, 1 }, { 1, 1 }, { 1, 1 } } };
+            DirtyTracker*       dirtyTracker{ nullptr };
+#if EMU_CONFIG_MEMORY_STATS
+            uint32_t            statsIndex{ 0 };
+#endif
         };
 
         struct Page
@@ -82,12 +218,171 @@ namespace emu
                 AddrType        mBase;
                 AddrType        mLimit;
                 AddrType        mOffset;
+                AddrType        mMask;
                 Accessor*       mAccessor;
+
+                bool operator==(const Item& other) const
+                {
+                    return (mBase == other.mBase) && (mLimit == other.mLimit) && isSameTarget(*this, other);
+                }
             };
 
             std::vector<Item>   mItems;
         };
 
+        struct Watch
+        {
+            uint32_t            mId;
+            AddrType            mBase;
+            AddrType            mLimit;
+            uint32_t            mFlags;
+        };
+
+        struct Mapping
+        {
+            std::vector<Page>   mPages;
+        };
+
+        struct TrackedRange
+        {
+            AddrType            mBase;
+            AddrType            mLimit;
+            AddrType            mMask;
+            DirtyTracker*       mTracker;
+        };
+
+        struct FastPage
+        {
+            // Host address matching guest address 0 for the accessor covering the whole page, 0 if the slow path must be used.
+            // Taking dirty pages traps writes again from the consumer's thread, so the write pointer is a relaxed atomic.
+            uintptr_t           mRead;
+            std::atomic<uintptr_t> mWrite;
+            const Timing*       mTiming;
+#if EMU_CONFIG_MEMORY_STATS
+            uint32_t            mStatsIndex;
+#endif
+        };
+
+        static const AddrType   FAST_PAGE_SIZE_LOG2 = 12;
+        static const size_t     PAGE_ITEM_RESERVE = 8;
+        static const uint32_t   WATCH_READ = 0x01;
+        static const uint32_t   WATCH_WRITE = 0x02;
+
+        // Dirty pages of a block of memory, indexed by offset in the memory so every bus and mirror mapping it shares
+        // them. Each bus mapping the memory has its own bits, only cleared when it takes dirty pages, and a page traps
+        // writes on all its aliases while one of them is clean. Buses update each other's fast pages, their mappings
+        // must not change while another thread writes to the memory.
+        class DirtyTracker
+        {
+        public:
+            ~DirtyTracker()
+            {
+                EMU_ASSERT(mClients.empty());
+            }
+
+            bool create(size_t size)
+            {
+                EMU_VERIFY(size > 0);
+                mPageCount = (size + (static_cast<size_t>(1) << FAST_PAGE_SIZE_LOG2) - 1) >> FAST_PAGE_SIZE_LOG2;
+                return true;
+            }
+
+        private:
+            friend class MemoryBusT;
+
+            struct Client
+            {
+                MemoryBusT*     mBus;
+                std::unique_ptr<std::atomic<uint64_t>[]> mDirtyPages;
+            };
+
+            void addClient(MemoryBusT& bus)
+            {
+                Client client;
+                client.mBus = &bus;
+                client.mDirtyPages.reset(new std::atomic<uint64_t>[(mPageCount + 63) >> 6]);
+                mClients.push_back(std::move(client));
+                resetClient(mClients.back());
+            }
+
+            void resetClient(const Client& client)
+            {
+                // Every page starts dirty, like on the bus
+                for (size_t wordIndex = 0; wordIndex < (mPageCount + 63) >> 6; ++wordIndex)
+                    client.mDirtyPages[wordIndex].store(~static_cast<uint64_t>(0), std::memory_order_relaxed);
+            }
+
+            void removeClient(MemoryBusT& bus)
+            {
+                auto client = std::find_if(mClients.begin(), mClients.end(), [&bus](const Client& item) { return item.mBus == &bus; });
+                if (client != mClients.end())
+                    mClients.erase(client);
+            }
+
+            const Client* findClient(const MemoryBusT& bus) const
+            {
+                for (const auto& client : mClients)
+                {
+                    if (client.mBus == &bus)
+                        return &client;
+                }
+                return nullptr;
+            }
+
+            bool isDirty(const Client& client, AddrType page) const
+            {
+                return (client.mDirtyPages[page >> 6].load(std::memory_order_acquire) & getMask(page)) != 0;
+            }
+
+            bool isTrapped(AddrType page) const
+            {
+                EMU_ASSERT(page < mPageCount);
+                for (const auto& client : mClients)
+                {
+                    if (!(client.mDirtyPages[page >> 6].load(std::memory_order_relaxed) & getMask(page)))
+                        return true;
+                }
+                return false;
+            }
+
+            // Returns true when the page was clean for at least one bus
+            bool markDirty(AddrType page)
+            {
+                EMU_ASSERT(page < mPageCount);
+                bool changed = false;
+                for (auto& client : mClients)
+                {
+                    auto& word = client.mDirtyPages[page >> 6];
+                    if (word.load(std::memory_order_relaxed) & getMask(page))
+                        continue;
+                    word.fetch_or(getMask(page), std::memory_order_acq_rel);
+                    changed = true;
+                }
+                return changed;
+            }
+
+            void takeDirty(const Client& client, AddrType page)
+            {
+                client.mDirtyPages[page >> 6].fetch_and(~getMask(page), std::memory_order_acq_rel);
+            }
+
+            static uint64_t getMask(AddrType page)
+            {
+                return static_cast<uint64_t>(1) << (page & 63);
+            }
+
+            size_t              mPageCount{ 0 };
+            std::vector<Client> mClients;
+        };
+
+        MemoryBusT() = default;
+
+        ~MemoryBusT()
+        {
+            for (auto tracker : mDirtyTrackers)
+                tracker->removeClient(*this);
+        }
+
         bool create(AddrType memSizeLog2, AddrType pageSizeLog2)
         {
             EMU_VERIFY(memSizeLog2 <= 8 * sizeof(AddrType));
@@ -101,9 +396,10 @@ namespace emu
             AddrType pageSize = mPageLimit + static_cast<AddrType>(1);
             AddrType pageCount = static_cast<AddrType>(1) << (mMemSizeLog2 - mPageSizeLog2);
             mPages.resize(pageCount);
-            Page::Item pageItem = { 0, mPageLimit, 0, &mInvalidMemory };
+            typename Page::Item pageItem = { 0, mPageLimit, 0, ~static_cast<AddrType>(0), &mInvalidMemory };
             for (AddrType pageIndex = 0; pageIndex < pageCount; ++pageIndex)
             {
+                mPages[pageIndex].mItems.reserve(PAGE_ITEM_RESERVE);
                 mPages[pageIndex].mItems.push_back(pageItem);
 
                 pageItem.mBase += pageSize;
@@ -111,28 +407,55 @@ namespace emu
                 pageItem.mOffset += pageSize;
             }
 
+            mFastPageSizeLog2 = (pageSizeLog2 < FAST_PAGE_SIZE_LOG2) ? pageSizeLog2 : FAST_PAGE_SIZE_LOG2;
+            mFastPageLimit = (static_cast<AddrType>(1) << mFastPageSizeLog2) - static_cast<AddrType>(1);
+            AddrType fastPageCount = static_cast<AddrType>(1) << (mMemSizeLog2 - mFastPageSizeLog2);
+            mFastPageCount = fastPageCount;
+            mFastPages.reset(new FastPage[fastPageCount]());
+            for (AddrType fastPageIndex = 0; fastPageIndex < fastPageCount; ++fastPageIndex)
+                mFastPages[fastPageIndex].mTiming = &mInvalidMemory.timing;
+            mTraps.assign(fastPageCount, 0);
+
             return true;
         }
 
         bool addRange(AddrType base, AddrType size, Accessor& accessor)
         {
+            return addMirroredRange(base, size, ~static_cast<AddrType>(0), accessor);
+        }
+
+        bool addMirroredRange(AddrType base, AddrType size, AddrType mirrorMask, Accessor& accessor)
+        {
+            // Every address in the range maps to the accessor at ((addr - base) & mirrorMask)
             EMU_VERIFY((base & 0x0f) == 0);
             EMU_VERIFY((size & 0x0f) == 0);
+            EMU_VERIFY((mirrorMask & 0x0f) == 0x0f);
+            EMU_VERIFY(((mirrorMask + 1) & mirrorMask) == 0);
 
             AddrType limit = base + size - 1;
             EMU_VERIFY(limit >= base);
             EMU_VERIFY(limit <= mMemLimit);
 
+            // Tracked pages are fast pages, each alias must line up with a whole page of the memory
+            if (accessor.dirtyTracker)
+            {
+                EMU_VERIFY(mFastPageSizeLog2 == FAST_PAGE_SIZE_LOG2);
+                EMU_VERIFY((base & mFastPageLimit) == 0);
+                EMU_VERIFY((mirrorMask & mFastPageLimit) == mFastPageLimit);
+                addTrackedRange(base, limit, mirrorMask, *accessor.dirtyTracker);
+            }
+
             AddrType pageIndexLimit = limit >> mPageSizeLog2;
             AddrType pageBase = base & ~mPageLimit;
             AddrType pageSize = mPageLimit + 1;
             AddrType pageLimit = pageBase + mPageLimit;
             for (AddrType pageIndex = base >> mPageSizeLog2; pageIndex <= pageIndexLimit; ++pageIndex)
             {
-                Page::Item newItem;
+                typename Page::Item newItem;
                 newItem.mBase = std::max(base, pageBase);
                 newItem.mLimit = std::min(limit, pageLimit);
                 newItem.mOffset = base;
+                newItem.mMask = mirrorMask;
                 newItem.mAccessor = &accessor;
 
                 auto& page = mPages[pageIndex];
@@ -142,31 +465,50 @@ namespace emu
                 while (item->mLimit < newItem.mBase)
                     ++item;
 
-                // Slice previous item in two at base address if applicable
-                if (item->mBase < newItem.mBase)
+                if ((item->mBase == newItem.mBase) && (item->mLimit == newItem.mLimit))
                 {
-                    Page::Item nextItem = *item;
-                    auto delta = newItem.mBase - nextItem.mBase;
-                    nextItem.mBase += delta;
-                    nextItem.mOffset += delta;
-
-                    item->mLimit = newItem.mBase - 1;
-                    item = page.mItems.insert(item, nextItem);
+                    // Remapping an existing range swaps the target in place
+                    *item = newItem;
                 }
+                else
+                {
+                    // Slice previous item in two at base address if applicable
+                    if (item->mBase < newItem.mBase)
+                    {
+                        typename Page::Item nextItem = *item;
+                        auto delta = newItem.mBase - nextItem.mBase;
+                        nextItem.mBase += delta;
 
-                // Insert our item
-                item = ++page.mItems.insert(item, newItem);
+                        item->mLimit = newItem.mBase - 1;
+                        item = page.mItems.insert(item + 1, nextItem);
+                    }
 
-                // Now remove all items with a limit smaller than our limit
-                while ((item != page.mItems.end()) && (item->mLimit <= newItem.mLimit))
-                    item = page.mItems.erase(item);
+                    // Insert our item
+                    item = page.mItems.insert(item, newItem);
+                    auto next = item + 1;
+
+                    // Now remove all items with a limit smaller than our limit
+                    while ((next != page.mItems.end()) && (next->mLimit <= newItem.mLimit))
+                        next = page.mItems.erase(next);
+
+                    // Now make sure the next item starts right after our new item limit
+                    if ((next != page.mItems.end()) && (next->mBase <= newItem.mLimit))
+                    {
+                        auto delta = newItem.mLimit + 1 - next->mBase;
+                        next->mBase += delta;
+                    }
+                }
 
-                // Now make sure the current item starts right after our new item limit
-                if ((item != page.mItems.end()) && (item->mBase <= newItem.mLimit))
+                // Merge with identical neighbors so repeated bank switches don't fragment the page
+                if ((item + 1 != page.mItems.end()) && isSameTarget(*item, *(item + 1)))
                 {
-                    auto delta = newItem.mLimit + 1 - item->mBase;
-                    item->mBase += delta;
-                    item->mOffset += delta;
+                    item->mLimit = (item + 1)->mLimit;
+                    page.mItems.erase(item + 1);
+                }
+                if ((item != page.mItems.begin()) && isSameTarget(*(item - 1), *item))
+                {
+                    (item - 1)->mLimit = item->mLimit;
+                    page.mItems.erase(item);
                 }
 
                 EMU_ASSERT(validatePage(page, pageBase, pageSize));
@@ -174,64 +516,678 @@ namespace emu
                 pageBase += pageSize;
                 pageLimit += pageSize;
             }
+
+            // The range holds different data now
+            if (mDirtyPages)
+                setDirty(base, limit);
+            updateFastPages(base, limit);
             return true;
         }
 
+        bool unmapRange(AddrType base, AddrType size)
+        {
+            return addRange(base, size, mInvalidMemory);
+        }
+
+        void saveMapping(Mapping& mapping) const
+        {
+            // Assignments reuse the capacity of a previously saved mapping so saving doesn't allocate once warmed up
+            mapping.mPages.resize(mPages.size());
+            for (size_t pageIndex = 0; pageIndex < mPages.size(); ++pageIndex)
+                mapping.mPages[pageIndex].mItems = mPages[pageIndex].mItems;
+        }
+
+        bool restoreMapping(const Mapping& mapping)
+        {
+            // Only the items that differ from the current mapping need their fast pages updated
+            EMU_VERIFY(mapping.mPages.size() == mPages.size());
+            for (size_t pageIndex = 0; pageIndex < mPages.size(); ++pageIndex)
+            {
+                auto& items = mPages[pageIndex].mItems;
+                const auto& newItems = mapping.mPages[pageIndex].mItems;
+                if (items == newItems)
+                    continue;
+
+                mChangedItems.clear();
+                for (const auto& newItem : newItems)
+                {
+                    if (std::find(items.begin(), items.end(), newItem) == items.end())
+                        mChangedItems.push_back(newItem);
+                }
+                items = newItems;
+                for (const auto& item : mChangedItems)
+                {
+                    if (mDirtyPages)
+                        setDirty(item.mBase, item.mLimit);
+                    updateFastPages(item.mBase, item.mLimit);
+                }
+            }
+            return true;
+        }
+
+        bool enableDirtyTracking()
+        {
+            // Every page starts dirty, consumers take a baseline by clearing what they are interested in
+            size_t wordCount = (static_cast<size_t>(mFastPageCount) + 63) >> 6;
+            mDirtyPages.reset(new std::atomic<uint64_t>[wordCount]);
+            for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex)
+                mDirtyPages[wordIndex].store(~static_cast<uint64_t>(0), std::memory_order_relaxed);
+            for (auto tracker : mDirtyTrackers)
+                tracker->resetClient(*tracker->findClient(*this));
+            return true;
+        }
+
+        void disableDirtyTracking()
+        {
+            // Pages of shared memory trapped only for this bus get their fast writes back on every bus
+            mDirtyPages.reset();
+            for (auto tracker : mDirtyTrackers)
+            {
+                tracker->resetClient(*tracker->findClient(*this));
+                for (const auto& client : tracker->mClients)
+                {
+                    if (client.mBus != this)
+                        client.mBus->updateFastPages(0, client.mBus->mMemLimit);
+                }
+            }
+            updateFastPages(0, mMemLimit);
+        }
+
+        // Guest pages mirror the bits of the tracked memory they map, checking them stays a single bit test
+        bool isDirty(AddrType addr) const
+        {
+            EMU_ASSERT(mDirtyPages);
+            AddrType fastPageIndex = addr >> mFastPageSizeLog2;
+            uint64_t mask = static_cast<uint64_t>(1) << (fastPageIndex & 63);
+            return (mDirtyPages[fastPageIndex >> 6].load(std::memory_order_acquire) & mask) != 0;
+        }
+
+        template <typename TFunc>
+        void takeDirtyPages(AddrType base, AddrType size, TFunc func)
+        {
+            // Dirty bits are cleared with an atomic fetch-and and func is called with the base address of each page that
+            // was dirty, and for tracked memory with every other page of this bus mapping the same memory. The page traps
+            // writes again before this returns, but a write that already passed the fast page check on another thread can
+            // still land unmarked: only writes ordered before the call are guaranteed to show.
+            EMU_ASSERT(mDirtyPages);
+            AddrType limit = base + size - 1;
+            EMU_ASSERT((limit >= base) && (limit <= mMemLimit));
+            AddrType fastPageIndex = base >> mFastPageSizeLog2;
+            AddrType fastPageIndexLimit = limit >> mFastPageSizeLog2;
+            while (fastPageIndex <= fastPageIndexLimit)
+            {
+                AddrType bitStart = fastPageIndex & 63;
+                AddrType bitCount = std::min<AddrType>(64 - bitStart, fastPageIndexLimit - fastPageIndex + 1);
+                uint64_t mask = ((bitCount == 64) ? ~static_cast<uint64_t>(0) : ((static_cast<uint64_t>(1) << bitCount) - 1)) << bitStart;
+                uint64_t dirty = mDirtyPages[fastPageIndex >> 6].fetch_and(~mask, std::memory_order_acq_rel) & mask;
+                size_t bit;
+                while (platform::findFirstBit(bit, dirty))
+                {
+                    dirty &= dirty - 1;
+                    AddrType pageBase = ((fastPageIndex & ~static_cast<AddrType>(63)) + static_cast<AddrType>(bit)) << mFastPageSizeLog2;
+                    auto item = findPageItem(pageBase);
+                    auto tracker = item->mAccessor->dirtyTracker;
+                    if (!tracker)
+                    {
+                        func(pageBase);
+                        updateFastWrite(pageBase >> mFastPageSizeLog2, *item);
+                        continue;
+                    }
+
+                    AddrType page = getTrackedPage(*item, pageBase);
+                    tracker->takeDirty(*tracker->findClient(*this), page);
+                    forEachAlias(*tracker, page, func);
+                    updateTrackedClients(*tracker, page);
+                }
+                fastPageIndex += bitCount;
+            }
+        }
+
+        void setWatchDelegate(WatchDelegate value)
+        {
+            mWatchDelegate = value;
+        }
+
+        uint32_t addWatchpoint(AddrType base, AddrType size, uint32_t flags)
+        {
+            // Only the pages holding the range are diverted to the slow path where watches are checked
+            EMU_ASSERT(size && (base + size - 1 >= base) && (base + size - 1 <= mMemLimit));
+            Watch watch = { ++mWatchId, base, base + size - 1, flags };
+            mWatches.push_back(watch);
+            updateWatchTraps(watch.mBase, watch.mLimit);
+            return watch.mId;
+        }
+
+        bool removeWatchpoint(uint32_t id)
+        {
+            auto watch = std::find_if(mWatches.begin(), mWatches.end(), [id](const Watch& item) { return item.mId == id; });
+            EMU_VERIFY(watch != mWatches.end());
+            AddrType base = watch->mBase;
+            AddrType limit = watch->mLimit;
+            mWatches.erase(watch);
+            updateWatchTraps(base, limit);
+            return true;
+        }
+
+        // Code caches track fast pages, only pages entirely backed by memory can be read directly
+        AddrType getFastPageSize() const
+        {
+            return mFastPageLimit + 1;
+        }
+
+        bool isFastPageReadable(AddrType addr) const
+        {
+            return mFastPages[addr >> mFastPageSizeLog2].mRead != 0;
+        }
+
+        const Timing& getFastPageTiming(AddrType addr) const
+        {
+            return *mFastPages[addr >> mFastPageSizeLog2].mTiming;
+        }
+
+        // Generated code walks the fast page table itself, the table is never reallocated once created
+        const FastPage* getFastPages() const
+        {
+            return mFastPages.get();
+        }
+
+        AddrType getFastPageSizeLog2() const
+        {
+            return mFastPageSizeLog2;
+        }
+
+        AddrType getMemLimit() const
+        {
+            return mMemLimit;
+        }
+
+        // True when the address is backed by plain memory, false when reads go to device handlers
+        bool isMemory(AddrType addr)
+        {
+            EMU_ASSERT(addr <= mMemLimit);
+            if (mFastPages[addr >> mFastPageSizeLog2].mRead)
+                return true;
+            return findPageItem(addr)->mAccessor->readMemory != nullptr;
+        }
+
+        uint8_t read8(AddrType addr)
+        {
+            return readValue<uint8_t>(addr);
+        }
+
+        uint16_t read16(AddrType addr)
+        {
+            return readValue<uint16_t>(addr);
+        }
+
+        uint32_t read32(AddrType addr)
+        {
+            return readValue<uint32_t>(addr);
+        }
+
         DataType read(AddrType addr)
         {
+            return readValue<DataType>(addr);
+        }
+
+        void write8(AddrType addr, uint8_t value)
+        {
+            writeValue(addr, value);
+        }
+
+        void write16(AddrType addr, uint16_t value)
+        {
+            writeValue(addr, value);
+        }
+
+        void write32(AddrType addr, uint32_t value)
+        {
+            writeValue(addr, value);
+        }
+
+        void write(AddrType addr, DataType value)
+        {
+            writeValue(addr, value);
+        }
+
+        // Timed accesses add the cost of the access to cycles, using the same page lookup as the access itself
+        uint8_t read8(AddrType addr, uint32_t& cycles, bool sequential)
+        {
+            return readTimed<uint8_t>(addr, cycles, sequential);
+        }
+
+        uint16_t read16(AddrType addr, uint32_t& cycles, bool sequential)
+        {
+            return readTimed<uint16_t>(addr, cycles, sequential);
+        }
+
+        uint32_t read32(AddrType addr, uint32_t& cycles, bool sequential)
+        {
+            return readTimed<uint32_t>(addr, cycles, sequential);
+        }
+
+        void write8(AddrType addr, uint8_t value, uint32_t& cycles, bool sequential)
+        {
+            writeTimed(addr, value, cycles, sequential);
+        }
+
+        void write16(AddrType addr, uint16_t value, uint32_t& cycles, bool sequential)
+        {
+            writeTimed(addr, value, cycles, sequential);
+        }
+
+        void write32(AddrType addr, uint32_t value, uint32_t& cycles, bool sequential)
+        {
+            writeTimed(addr, value, cycles, sequential);
+        }
+
+        void read(AddrType addr, DataType* data, size_t count)
+        {
+            // Each span covered by a single accessor mirror is resolved once
+            while (count)
+            {
+                EMU_ASSERT(addr <= mMemLimit);
+                auto item = findPageItem(addr);
+                auto accessor = item->mAccessor;
+                auto addrFixed = (addr - item->mOffset) & item->mMask;
+                size_t spanCount = getSpanCount(*item, addr, addrFixed, count);
+                EMU_MEMORY_STATS(MemoryStats::countRead<DataType>(accessor->statsIndex, false, spanCount));
+                if (accessor->readMemory)
+                {
+                    memcpy(data, accessor->readMemory + addrFixed, spanCount * sizeof(DataType));
+                }
+                else
+                {
+                    for (size_t index = 0; index < spanCount; ++index)
+                        data[index] = accessor->callRead(addr + static_cast<AddrType>(index * sizeof(DataType)), DataType());
+                }
+                if (!mWatches.empty())
+                    checkWatchSpan(addr, data, spanCount, false);
+                data += spanCount;
+                addr += static_cast<AddrType>(spanCount * sizeof(DataType));
+                count -= spanCount;
+            }
+        }
+
+        void write(AddrType addr, const DataType* data, size_t count)
+        {
+            // Each span covered by a single accessor mirror is resolved once
+            while (count)
+            {
+                EMU_ASSERT(addr <= mMemLimit);
+                auto item = findPageItem(addr);
+                auto accessor = item->mAccessor;
+                auto addrFixed = (addr - item->mOffset) & item->mMask;
+                size_t spanCount = getSpanCount(*item, addr, addrFixed, count);
+                EMU_MEMORY_STATS(MemoryStats::countWrite<DataType>(accessor->statsIndex, false, spanCount));
+                if (accessor->writeMemory)
+                {
+                    memcpy(accessor->writeMemory + addrFixed, data, spanCount * sizeof(DataType));
+                    markDirty(*item, addr, addr + static_cast<AddrType>(spanCount * sizeof(DataType) - 1));
+                }
+                else
+                {
+                    for (size_t index = 0; index < spanCount; ++index)
+                        accessor->callWrite(addr + static_cast<AddrType>(index * sizeof(DataType)), data[index]);
+                }
+                if (!mWatches.empty())
+                    checkWatchSpan(addr, data, spanCount, true);
+                data += spanCount;
+                addr += static_cast<AddrType>(spanCount * sizeof(DataType));
+                count -= spanCount;
+            }
+        }
+
+        // Watch flags of the page holding addr, handlers that bypass the bus must fall back to it when set
+        uint32_t getTraps(AddrType addr) const
+        {
+            return mTraps[addr >> mFastPageSizeLog2];
+        }
+
+        // Typed timed accesses, memory maps built on top of the bus dispatch to these for regions they don't handle
+        template <typename T>
+        T readTimed(AddrType addr, uint32_t& cycles, bool sequential)
+        {
+            EMU_ASSERT(addr <= mMemLimit);
+            const auto& fastPage = mFastPages[addr >> mFastPageSizeLog2];
+            if (fastPage.mRead)
+            {
+                EMU_MEMORY_STATS(MemoryStats::countRead<T>(fastPage.mStatsIndex, true));
+                cycles += fastPage.mTiming->template get<T>(sequential);
+                return *reinterpret_cast<const T*>(fastPage.mRead + (addr ^ endianSwizzle<T>()));
+            }
+            auto item = findPageItem(addr);
+            cycles += item->mAccessor->timing.template get<T>(sequential);
+            return readItem<T>(*item, addr);
+        }
+
+        template <typename T>
+        void writeTimed(AddrType addr, T value, uint32_t& cycles, bool sequential)
+        {
+            EMU_ASSERT(addr <= mMemLimit);
+            const auto& fastPage = mFastPages[addr >> mFastPageSizeLog2];
+            uintptr_t write = fastPage.mWrite.load(std::memory_order_relaxed);
+            if (write)
+            {
+                EMU_MEMORY_STATS(MemoryStats::countWrite<T>(fastPage.mStatsIndex, true));
+                cycles += fastPage.mTiming->template get<T>(sequential);
+                *reinterpret_cast<T*>(write + (addr ^ endianSwizzle<T>())) = value;
+                return;
+            }
             auto item = findPageItem(addr);
-            auto addrFixed = addr - item->mOffset;
-            auto accessor = item->mAccessor;
+            cycles += item->mAccessor->timing.template get<T>(sequential);
+            writeItem(*item, addr, value);
+        }
+
+    private:
+        template <typename T>
+        static AddrType endianSwizzle()
+        {
+            // Memory is stored as native DataType words, narrower accesses must be remapped on big endian hosts
+            return EMU_CONFIG_LITTLE_ENDIAN ? 0 : static_cast<AddrType>(sizeof(DataType) - sizeof(T));
+        }
+
+        template <typename T>
+        T readValue(AddrType addr)
+        {
+            EMU_ASSERT(addr <= mMemLimit);
+            const auto& fastPage = mFastPages[addr >> mFastPageSizeLog2];
+            if (fastPage.mRead)
+            {
+                EMU_MEMORY_STATS(MemoryStats::countRead<T>(fastPage.mStatsIndex, true));
+                return *reinterpret_cast<const T*>(fastPage.mRead + (addr ^ endianSwizzle<T>()));
+            }
+            return readSlow<T>(addr);
+        }
+
+        template <typename T>
+        void writeValue(AddrType addr, T value)
+        {
+            EMU_ASSERT(addr <= mMemLimit);
+            const auto& fastPage = mFastPages[addr >> mFastPageSizeLog2];
+            uintptr_t write = fastPage.mWrite.load(std::memory_order_relaxed);
+            if (write)
+            {
+                EMU_MEMORY_STATS(MemoryStats::countWrite<T>(fastPage.mStatsIndex, true));
+                *reinterpret_cast<T*>(write + (addr ^ endianSwizzle<T>())) = value;
+            }
+            else
+            {
+                writeSlow(addr, value);
+            }
+        }
+
+        template <typename T>
+        T readSlow(AddrType addr)
+        {
+            return readItem<T>(*findPageItem(addr), addr);
+        }
+
+        template <typename T>
+        void writeSlow(AddrType addr, T value)
+        {
+            writeItem(*findPageItem(addr), addr, value);
+        }
+
+        template <typename T>
+        T readItem(const typename Page::Item& item, AddrType addr)
+        {
+            auto addrFixed = (addr - item.mOffset) & item.mMask;
+            auto accessor = item.mAccessor;
+            EMU_MEMORY_STATS(MemoryStats::countRead<T>(accessor->statsIndex, false));
+            T value;
             if (accessor->readMemory)
             {
-                return *reinterpret_cast<const DataType*>(accessor->readMemory + addrFixed);
+                value = *reinterpret_cast<const T*>(accessor->readMemory + (addrFixed ^ endianSwizzle<T>()));
             }
             else
             {
-                return accessor->readFunc(addr);
+                value = accessor->callRead(addr, T());
             }
+            if (mTraps[addr >> mFastPageSizeLog2] & WATCH_READ)
+                checkWatch(addr, value, sizeof(T), false);
+            return value;
         }
 
-        void write(AddrType addr, DataType value)
+        template <typename T>
+        void writeItem(const typename Page::Item& item, AddrType addr, T value)
         {
-            auto item = findPageItem(addr);
-            auto addrFixed = addr - item->mOffset;
-            auto accessor = item->mAccessor;
+            auto addrFixed = (addr - item.mOffset) & item.mMask;
+            auto accessor = item.mAccessor;
+            EMU_MEMORY_STATS(MemoryStats::countWrite<T>(accessor->statsIndex, false));
             if (accessor->writeMemory)
             {
-                *reinterpret_cast<DataType*>(accessor->writeMemory + addrFixed) = value;
+                *reinterpret_cast<T*>(accessor->writeMemory + (addrFixed ^ endianSwizzle<T>())) = value;
+                markDirty(item, addr, addr);
             }
             else
             {
-                return accessor->writeFunc(addr, value);
+                accessor->callWrite(addr, value);
             }
+            if (mTraps[addr >> mFastPageSizeLog2] & WATCH_WRITE)
+                checkWatch(addr, value, sizeof(T), true);
         }
 
-        void read(AddrType addr, DataType* data, size_t count)
+        void checkWatch(AddrType addr, DataType value, uint32_t size, bool write)
         {
-            for (size_t index = 0; index < count; ++index)
+            uint32_t flag = write ? WATCH_WRITE : WATCH_READ;
+            AddrType limit = addr + size - 1;
+            for (const auto& watch : mWatches)
             {
-                data[index] = read(addr);
-                addr += sizeof(DataType);
+                if ((watch.mFlags & flag) && (watch.mBase <= limit) && (watch.mLimit >= addr))
+                    mWatchDelegate(addr, value, size, write);
             }
         }
 
-        void write(AddrType addr, const DataType* data, size_t count)
+        void checkWatchSpan(AddrType addr, const DataType* data, size_t count, bool write)
         {
+            // Bulk transfers bypass the per access slow path, check each element on trapped pages
+            uint32_t flag = write ? WATCH_WRITE : WATCH_READ;
             for (size_t index = 0; index < count; ++index)
             {
-                write(addr, data[index]);
-                addr += sizeof(DataType);
+                AddrType elementAddr = addr + static_cast<AddrType>(index * sizeof(DataType));
+                if (mTraps[elementAddr >> mFastPageSizeLog2] & flag)
+                    checkWatch(elementAddr, data[index], sizeof(DataType), write);
             }
         }
 
-    private:
+        void updateWatchTraps(AddrType base, AddrType limit)
+        {
+            AddrType fastPageIndexLimit = limit >> mFastPageSizeLog2;
+            for (AddrType fastPageIndex = base >> mFastPageSizeLog2; fastPageIndex <= fastPageIndexLimit; ++fastPageIndex)
+            {
+                AddrType fastPageBase = fastPageIndex << mFastPageSizeLog2;
+                AddrType fastPageLimit = fastPageBase + mFastPageLimit;
+                uint8_t traps = 0;
+                for (const auto& watch : mWatches)
+                {
+                    if ((watch.mBase <= fastPageLimit) && (watch.mLimit >= fastPageBase))
+                        traps |= static_cast<uint8_t>(watch.mFlags);
+                }
+                mTraps[fastPageIndex] = traps;
+                updateFastPages(fastPageBase, fastPageLimit);
+            }
+        }
+
+        void markDirty(const typename Page::Item& item, AddrType base, AddrType limit)
+        {
+            // Clean pages have their fast write disabled, the first write lands here and gives it back. Tracked memory
+            // is marked for every bus, all its aliases are updated.
+            auto tracker = item.mAccessor->dirtyTracker;
+            if (!tracker && !mDirtyPages)
+                return;
+            AddrType fastPageIndexLimit = limit >> mFastPageSizeLog2;
+            for (AddrType fastPageIndex = base >> mFastPageSizeLog2; fastPageIndex <= fastPageIndexLimit; ++fastPageIndex)
+            {
+                if (tracker)
+                {
+                    AddrType page = getTrackedPage(item, fastPageIndex << mFastPageSizeLog2);
+                    if (tracker->markDirty(page))
+                        updateTrackedClients(*tracker, page);
+                    continue;
+                }
+
+                auto& word = mDirtyPages[fastPageIndex >> 6];
+                uint64_t mask = static_cast<uint64_t>(1) << (fastPageIndex & 63);
+                if (word.load(std::memory_order_relaxed) & mask)
+                    continue;
+                word.fetch_or(mask, std::memory_order_acq_rel);
+                updateFastWrite(fastPageIndex);
+            }
+        }
+
+        void setDirty(AddrType base, AddrType limit)
+        {
+            AddrType fastPageIndexLimit = limit >> mFastPageSizeLog2;
+            for (AddrType fastPageIndex = base >> mFastPageSizeLog2; fastPageIndex <= fastPageIndexLimit; ++fastPageIndex)
+                mDirtyPages[fastPageIndex >> 6].fetch_or(static_cast<uint64_t>(1) << (fastPageIndex & 63), std::memory_order_acq_rel);
+        }
+
+        bool isWriteTrapped(AddrType fastPageIndex, const typename Page::Item& item) const
+        {
+            if (mTraps[fastPageIndex] & WATCH_WRITE)
+                return true;
+            if (item.mAccessor->dirtyTracker)
+                return item.mAccessor->dirtyTracker->isTrapped(getTrackedPage(item, fastPageIndex << mFastPageSizeLog2));
+            if (!mDirtyPages)
+                return false;
+            uint64_t mask = static_cast<uint64_t>(1) << (fastPageIndex & 63);
+            return (mDirtyPages[fastPageIndex >> 6].load(std::memory_order_relaxed) & mask) == 0;
+        }
+
+        static AddrType getTrackedPage(const typename Page::Item& item, AddrType addr)
+        {
+            return ((addr - item.mOffset) & item.mMask) >> FAST_PAGE_SIZE_LOG2;
+        }
+
+        void addTrackedRange(AddrType base, AddrType limit, AddrType mask, DirtyTracker& tracker)
+        {
+            // Ranges are kept when remapped, aliases are checked against the current mapping when used
+            TrackedRange range = { base, limit, mask, &tracker };
+            auto same = [&range](const TrackedRange& item)
+            {
+                return (item.mBase == range.mBase) && (item.mLimit == range.mLimit) && (item.mMask == range.mMask) && (item.mTracker == range.mTracker);
+            };
+            if (std::find_if(mTrackedRanges.begin(), mTrackedRanges.end(), same) == mTrackedRanges.end())
+                mTrackedRanges.push_back(range);
+            if (std::find(mDirtyTrackers.begin(), mDirtyTrackers.end(), &tracker) == mDirtyTrackers.end())
+            {
+                tracker.addClient(*this);
+                mDirtyTrackers.push_back(&tracker);
+            }
+        }
+
+        // Calls func with the base of each fast page of this bus currently mapping the page of tracked memory
+        template <typename TFunc>
+        void forEachAlias(const DirtyTracker& tracker, AddrType page, TFunc func)
+        {
+            AddrType offset = page << FAST_PAGE_SIZE_LOG2;
+            for (const auto& range : mTrackedRanges)
+            {
+                if (range.mTracker != &tracker)
+                    continue;
+                // Ranges start on the first page of the memory, then come back to it once per mirror
+                AddrType addr = range.mBase + offset;
+                while ((addr >= range.mBase) && (addr <= range.mLimit))
+                {
+                    auto item = findPageItem(addr);
+                    if ((item->mAccessor->dirtyTracker == &tracker) && (getTrackedPage(*item, addr) == page))
+                        func(addr);
+                    if (range.mMask == ~static_cast<AddrType>(0))
+                        break;
+                    addr += range.mMask + 1;
+                }
+            }
+        }
+
+        // Every bus mapping tracked memory is a client of its tracker
+        static void updateTrackedClients(const DirtyTracker& tracker, AddrType page)
+        {
+            for (const auto& client : tracker.mClients)
+                client.mBus->updateTrackedPage(tracker, page);
+        }
+
+        // Copies the dirty state of a tracked page to every alias of this bus and updates their fast writes
+        void updateTrackedPage(const DirtyTracker& tracker, AddrType page)
+        {
+            auto client = mDirtyPages ? tracker.findClient(*this) : nullptr;
+            bool dirty = client && tracker.isDirty(*client, page);
+            forEachAlias(tracker, page, [this, client, dirty](AddrType pageBase)
+            {
+                AddrType fastPageIndex = pageBase >> mFastPageSizeLog2;
+                if (client)
+                {
+                    uint64_t mask = static_cast<uint64_t>(1) << (fastPageIndex & 63);
+                    if (dirty)
+                        mDirtyPages[fastPageIndex >> 6].fetch_or(mask, std::memory_order_acq_rel);
+                    else
+                        mDirtyPages[fastPageIndex >> 6].fetch_and(~mask, std::memory_order_acq_rel);
+                }
+                updateFastWrite(fastPageIndex);
+            });
+        }
+
+        void updateFastPages(AddrType base, AddrType limit)
+        {
+            AddrType fastPageIndexLimit = limit >> mFastPageSizeLog2;
+            for (AddrType fastPageIndex = base >> mFastPageSizeLog2; fastPageIndex <= fastPageIndexLimit; ++fastPageIndex)
+            {
+                AddrType fastPageBase = fastPageIndex << mFastPageSizeLog2;
+                auto item = findPageItem(fastPageBase);
+                auto accessor = item->mAccessor;
+                auto& fastPage = mFastPages[fastPageIndex];
+                fastPage.mRead = (mTraps[fastPageIndex] & WATCH_READ) ? 0 : getFastHost(*item, fastPageBase, accessor->readMemory);
+                fastPage.mTiming = &accessor->timing;
+                EMU_MEMORY_STATS(fastPage.mStatsIndex = accessor->statsIndex);
+                updateFastWrite(fastPageIndex, *item);
+            }
+        }
+
+        void updateFastWrite(AddrType fastPageIndex)
+        {
+            updateFastWrite(fastPageIndex, *findPageItem(fastPageIndex << mFastPageSizeLog2));
+        }
+
+        void updateFastWrite(AddrType fastPageIndex, const typename Page::Item& item)
+        {
+            // Dirty tracking only ever changes the write pointer, the rest of the page is left alone
+            AddrType fastPageBase = fastPageIndex << mFastPageSizeLog2;
+            uintptr_t write = isWriteTrapped(fastPageIndex, item) ? 0 : getFastHost(item, fastPageBase, item.mAccessor->writeMemory);
+            mFastPages[fastPageIndex].mWrite.store(write, std::memory_order_relaxed);
+        }
+
+        uintptr_t getFastHost(const typename Page::Item& item, AddrType fastPageBase, const void* memory) const
+        {
+            // Only pages entirely covered by a single memory backed accessor can bypass the item list. Mirrors are folded
+            // into the page bias so the fast path never needs to apply the mask.
+            bool covered = item.mLimit >= fastPageBase + mFastPageLimit;
+            bool contiguous = (item.mMask & mFastPageLimit) == mFastPageLimit;
+            if (!memory || !covered || !contiguous)
+                return 0;
+            uintptr_t mirrorBias = static_cast<uintptr_t>((fastPageBase - item.mOffset) & item.mMask) - static_cast<uintptr_t>(fastPageBase);
+            return reinterpret_cast<uintptr_t>(memory) + mirrorBias;
+        }
+
+        static bool isSameTarget(const typename Page::Item& item, const typename Page::Item& other)
+        {
+            return (item.mOffset == other.mOffset) && (item.mMask == other.mMask) && (item.mAccessor == other.mAccessor);
+        }
+
+        static size_t getSpanCount(const typename Page::Item& item, AddrType addr, AddrType addrFixed, size_t count)
+        {
+            // Spans stop at the end of the item or at the end of the current mirror, whichever comes first
+            AddrType itemRemaining = item.mLimit - addr;
+            AddrType mirrorRemaining = item.mMask - (addrFixed & item.mMask);
+            AddrType remaining = std::min(itemRemaining, mirrorRemaining);
+            return std::min(count, static_cast<size_t>(remaining / sizeof(DataType)) + 1);
+        }
+
         typename Page::Item* findPageItem(AddrType addr)
         {
             EMU_ASSERT(addr <= mMemLimit);
             uint32_t pageIndex = addr >> mPageSizeLog2;
             auto item = mPages[pageIndex].mItems.data();
-            while (addr < item->mBase)
+            while (addr > item->mLimit)
                 ++item;
             return item;
         }
@@ -249,12 +1205,24 @@ namespace emu
             return true;
         }
 
-        AddrType            mMemSizeLog2{ 0 };
-        AddrType            mPageSizeLog2{ 0 };
-        AddrType            mMemLimit{ 0 };
-        AddrType            mPageLimit{ 0 };
-        Accessor            mInvalidMemory;
-        std::vector<Page>   mPages;
+        AddrType                mMemSizeLog2{ 0 };
+        AddrType                mPageSizeLog2{ 0 };
+        AddrType                mMemLimit{ 0 };
+        AddrType                mPageLimit{ 0 };
+        AddrType                mFastPageSizeLog2{ 0 };
+        AddrType                mFastPageLimit{ 0 };
+        Accessor                mInvalidMemory;
+        std::vector<Page>       mPages;
+        AddrType                mFastPageCount{ 0 };
+        std::unique_ptr<FastPage[]> mFastPages;
+        std::vector<typename Page::Item> mChangedItems;
+        std::unique_ptr<std::atomic<uint64_t>[]> mDirtyPages;
+        std::vector<uint8_t>    mTraps;
+        std::vector<Watch>      mWatches;
+        uint32_t                mWatchId{ 0 };
+        WatchDelegate           mWatchDelegate;
+        std::vector<TrackedRange> mTrackedRanges;
+        std::vector<DirtyTracker*> mDirtyTrackers;
     };
 
     typedef MemoryBusT<uint32_t, uint32_t> MemoryBus32;
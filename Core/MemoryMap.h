@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core.h"
+#include "MemoryBus.h"
+#include <tuple>
+
+namespace emu
+{
+    // Memory map resolved at compile time. Each region type covers the addresses whose top 8 bits are in
+    // [FIRST, LAST] and provides inline readTimed/writeTimed handlers. The region checks are constant compares
+    // the compiler folds into a branch tree or jump table, and the handlers inline into the caller.
+    // Addresses outside every region go to the runtime bus the map derives from, which tools keep using as is.
+    template <typename... TRegions>
+    class MemoryMapT : public MemoryBus32
+    {
+    public:
+        template <typename TRegion>
+        TRegion& getRegion()
+        {
+            return std::get<TRegion>(mRegions);
+        }
+
+        template <typename T>
+        T readTimed(uint32_t addr, uint32_t& cycles, bool sequential)
+        {
+            return dispatchRead<T, TRegions...>(addr, cycles, sequential);
+        }
+
+        template <typename T>
+        void writeTimed(uint32_t addr, T value, uint32_t& cycles, bool sequential)
+        {
+            dispatchWrite<T, TRegions...>(addr, value, cycles, sequential);
+        }
+
+    private:
+        template <typename T>
+        T dispatchRead(uint32_t addr, uint32_t& cycles, bool sequential)
+        {
+            return MemoryBus32::readTimed<T>(addr, cycles, sequential);
+        }
+
+        template <typename T, typename TRegion, typename... TRest>
+        T dispatchRead(uint32_t addr, uint32_t& cycles, bool sequential)
+        {
+            uint32_t index = addr >> 24;
+            if ((index >= TRegion::FIRST) && (index <= TRegion::LAST))
+                return getRegion<TRegion>().template readTimed<T>(*this, addr, cycles, sequential);
+            return dispatchRead<T, TRest...>(addr, cycles, sequential);
+        }
+
+        template <typename T>
+        void dispatchWrite(uint32_t addr, T value, uint32_t& cycles, bool sequential)
+        {
+            MemoryBus32::writeTimed<T>(addr, value, cycles, sequential);
+        }
+
+        template <typename T, typename TRegion, typename... TRest>
+        void dispatchWrite(uint32_t addr, T value, uint32_t& cycles, bool sequential)
+        {
+            uint32_t index = addr >> 24;
+            if ((index >= TRegion::FIRST) && (index <= TRegion::LAST))
+                return getRegion<TRegion>().template writeTimed<T>(*this, addr, value, cycles, sequential);
+            dispatchWrite<T, TRest...>(addr, value, cycles, sequential);
+        }
+
+        std::tuple<TRegions...>     mRegions;
+    };
+}
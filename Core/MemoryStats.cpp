@@ -0,0 +1,109 @@
+#include "MemoryStats.h"
+
+#if EMU_CONFIG_MEMORY_STATS
+
+#include <mutex>
+
+namespace
+{
+    std::mutex& getMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    std::vector<std::string>& getNames()
+    {
+        static std::vector<std::string> names(1, "(unnamed)");
+        return names;
+    }
+}
+
+namespace emu
+{
+    uint32_t MemoryStats::registerAccessor(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+        auto& names = getNames();
+        auto it = std::find(names.begin(), names.end(), name);
+        if (it != names.end())
+            return static_cast<uint32_t>(it - names.begin());
+        if (names.size() >= MAX_ACCESSORS)
+            return 0;
+        names.push_back(name);
+        return static_cast<uint32_t>(names.size() - 1);
+    }
+
+    std::vector<std::unique_ptr<MemoryStats::Block>>& MemoryStats::getBlocks()
+    {
+        // Blocks outlive their thread so counts from finished threads are kept
+        static std::vector<std::unique_ptr<Block>> blocks;
+        return blocks;
+    }
+
+    MemoryStats::Block& MemoryStats::createBlock()
+    {
+        std::unique_ptr<Block> block(new Block());
+        for (auto& accessor : block->counts)
+        {
+            for (auto& path : accessor)
+            {
+                for (auto& value : path)
+                    value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(getMutex());
+        auto& blocks = getBlocks();
+        blocks.push_back(std::move(block));
+        return *blocks.back();
+    }
+
+    void MemoryStats::capture(Snapshot& snapshot)
+    {
+        std::lock_guard<std::mutex> lock(getMutex());
+        const auto& names = getNames();
+        snapshot.entries.resize(names.size());
+        for (size_t index = 0; index < names.size(); ++index)
+        {
+            auto& entry = snapshot.entries[index];
+            entry.name = names[index];
+            for (uint32_t counter = 0; counter < COUNTER_COUNT; ++counter)
+            {
+                entry.fast[counter] = 0;
+                entry.slow[counter] = 0;
+                for (const auto& block : getBlocks())
+                {
+                    entry.fast[counter] += block->counts[index][0][counter].load(std::memory_order_relaxed);
+                    entry.slow[counter] += block->counts[index][1][counter].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+
+    void MemoryStats::dump(const Snapshot& current, const Snapshot& previous)
+    {
+        // Counters only ever grow, the difference between two snapshots is the activity in between
+        static const char* counterNames[COUNTER_COUNT] = { "R8", "R16", "R32", "W8", "W16", "W32" };
+        printf("%-24s %-4s %12s %12s\n", "Accessor", "Op", "Fast", "Slow");
+        for (size_t index = 0; index < current.entries.size(); ++index)
+        {
+            const auto& entry = current.entries[index];
+            for (uint32_t counter = 0; counter < COUNTER_COUNT; ++counter)
+            {
+                uint64_t fast = entry.fast[counter];
+                uint64_t slow = entry.slow[counter];
+                if (index < previous.entries.size())
+                {
+                    fast -= previous.entries[index].fast[counter];
+                    slow -= previous.entries[index].slow[counter];
+                }
+                if (fast || slow)
+                    printf("%-24s %-4s %12llu %12llu\n", entry.name.c_str(), counterNames[counter],
+                        static_cast<unsigned long long>(fast), static_cast<unsigned long long>(slow));
+            }
+        }
+    }
+}
+
+#endif
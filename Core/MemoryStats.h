@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Core.h"
+
+#if EMU_CONFIG_MEMORY_STATS
+#define EMU_MEMORY_STATS(expr)      expr
+#else
+#define EMU_MEMORY_STATS(expr)
+#endif
+
+#if EMU_CONFIG_MEMORY_STATS
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace emu
+{
+    class MemoryStats
+    {
+    public:
+        enum Counter
+        {
+            COUNTER_READ8,
+            COUNTER_READ16,
+            COUNTER_READ32,
+            COUNTER_WRITE8,
+            COUNTER_WRITE16,
+            COUNTER_WRITE32,
+            COUNTER_COUNT,
+        };
+
+        static const uint32_t   MAX_ACCESSORS = 256;
+
+        struct Entry
+        {
+            std::string         name;
+            uint64_t            fast[COUNTER_COUNT];
+            uint64_t            slow[COUNTER_COUNT];
+        };
+
+        struct Snapshot
+        {
+            std::vector<Entry>  entries;
+        };
+
+        // Accessors with the same name share their counters
+        static uint32_t registerAccessor(const std::string& name);
+        static void capture(Snapshot& snapshot);
+        static void dump(const Snapshot& current, const Snapshot& previous);
+
+        template <typename T>
+        static void countRead(uint32_t accessorIndex, bool fast, uint64_t count = 1)
+        {
+            increment(accessorIndex, COUNTER_READ8 + (sizeof(T) >> 1), fast, count);
+        }
+
+        template <typename T>
+        static void countWrite(uint32_t accessorIndex, bool fast, uint64_t count = 1)
+        {
+            increment(accessorIndex, COUNTER_WRITE8 + (sizeof(T) >> 1), fast, count);
+        }
+
+    private:
+        struct Block
+        {
+            // Only the owning thread writes its block, relaxed accesses keep snapshots free of data races
+            std::atomic<uint64_t>   counts[MAX_ACCESSORS][2][COUNTER_COUNT];
+        };
+
+        static std::vector<std::unique_ptr<Block>>& getBlocks();
+        static Block& createBlock();
+
+        static void increment(uint32_t accessorIndex, uint32_t counter, bool fast, uint64_t count)
+        {
+            static thread_local Block* block = nullptr;
+            if (!block)
+                block = &createBlock();
+            auto& value = block->counts[accessorIndex][fast ? 0 : 1][counter];
+            value.store(value.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "Scheduler.h"
+
+namespace emu
+{
+    Scheduler::Scheduler()
+    {
+    }
+
+    Scheduler::~Scheduler()
+    {
+        destroy();
+    }
+
+    bool Scheduler::create(size_t capacity)
+    {
+        destroy();
+        mHeap.reserve(capacity);
+        return true;
+    }
+
+    void Scheduler::destroy()
+    {
+        for (auto event : mHeap)
+            event->mHeapIndex = Event::INVALID_INDEX;
+        mHeap.clear();
+    }
+
+    void Scheduler::schedule(Event& event, Tick tick)
+    {
+        if (event.isScheduled())
+        {
+            // Rescheduling moves the event in place in whichever direction its new tick requires
+            Tick previousTick = event.mTick;
+            event.mTick = tick;
+            if (tick < previousTick)
+                siftUp(event.mHeapIndex);
+            else
+                siftDown(event.mHeapIndex);
+            return;
+        }
+
+        event.mTick = tick;
+        uint32_t index = static_cast<uint32_t>(mHeap.size());
+        mHeap.push_back(&event);
+        event.mHeapIndex = index;
+        siftUp(index);
+    }
+
+    void Scheduler::cancel(Event& event)
+    {
+        if (event.isScheduled())
+            remove(event.mHeapIndex);
+    }
+
+    void Scheduler::execute(Tick tick)
+    {
+        // Callbacks may schedule or cancel events, including the one being dispatched
+        while (!mHeap.empty() && (mHeap.front()->mTick <= tick))
+        {
+            Event* event = mHeap.front();
+            remove(0);
+            event->mCallback(event->mTick);
+        }
+    }
+
+    void Scheduler::siftUp(uint32_t index)
+    {
+        Event* event = mHeap[index];
+        while (index > 0)
+        {
+            uint32_t parent = (index - 1) >> 1;
+            if (mHeap[parent]->mTick <= event->mTick)
+                break;
+            place(index, mHeap[parent]);
+            index = parent;
+        }
+        place(index, event);
+    }
+
+    void Scheduler::siftDown(uint32_t index)
+    {
+        Event* event = mHeap[index];
+        uint32_t count = static_cast<uint32_t>(mHeap.size());
+        for (;;)
+        {
+            uint32_t child = (index << 1) + 1;
+            if (child >= count)
+                break;
+            if ((child + 1 < count) && (mHeap[child + 1]->mTick < mHeap[child]->mTick))
+                ++child;
+            if (event->mTick <= mHeap[child]->mTick)
+                break;
+            place(index, mHeap[child]);
+            index = child;
+        }
+        place(index, event);
+    }
+
+    void Scheduler::place(uint32_t index, Event* event)
+    {
+        mHeap[index] = event;
+        event->mHeapIndex = index;
+    }
+
+    void Scheduler::remove(uint32_t index)
+    {
+        Event* event = mHeap[index];
+        event->mHeapIndex = Event::INVALID_INDEX;
+
+        Event* last = mHeap.back();
+        mHeap.pop_back();
+        if (last == event)
+            return;
+
+        place(index, last);
+        siftUp(index);
+        siftDown(last->mHeapIndex);
+    }
+}
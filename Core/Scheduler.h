@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Core.h"
+#include "Delegate.h"
+#include <vector>
+
+namespace emu
+{
+    class Scheduler
+    {
+    public:
+        // Callbacks receive the tick the event was scheduled for so periodic events can reschedule without drift
+        typedef Delegate<void(Tick tick)> Callback;
+
+        static const Tick       NEVER = INT64_MAX;
+
+        class Event
+        {
+        public:
+            Event()
+                : mTick(NEVER)
+                , mHeapIndex(INVALID_INDEX)
+            {
+            }
+
+            Event& setCallback(Callback value)
+            {
+                mCallback = value;
+                return *this;
+            }
+
+            bool isScheduled() const
+            {
+                return mHeapIndex != INVALID_INDEX;
+            }
+
+            Tick getTick() const
+            {
+                return mTick;
+            }
+
+        private:
+            friend class Scheduler;
+
+            static const uint32_t   INVALID_INDEX = 0xffffffff;
+
+            Event(const Event&) = delete;
+            Event& operator=(const Event&) = delete;
+
+            Tick            mTick;
+            uint32_t        mHeapIndex;
+            Callback        mCallback;
+        };
+
+        Scheduler();
+        ~Scheduler();
+        bool create(size_t capacity);
+        void destroy();
+        void schedule(Event& event, Tick tick);
+        void cancel(Event& event);
+        void execute(Tick tick);
+
+        Tick getNextTick() const
+        {
+            return mHeap.empty() ? NEVER : mHeap.front()->mTick;
+        }
+
+    private:
+        void siftUp(uint32_t index);
+        void siftDown(uint32_t index);
+        void place(uint32_t index, Event* event);
+        void remove(uint32_t index);
+
+        // Events are owned by the devices using them, the heap only stores pointers and never allocates once reserved
+        std::vector<Event*>     mHeap;
+    };
+}
@@ -0,0 +1,119 @@
+#include "Cpu.h"
+#include <Core/CpuArmInterpreter.h>
+
+namespace
+{
+    typedef CpuArmInterpreterT<nds::Arm7MemoryMap> Arm7Interpreter;
+    typedef CpuArmInterpreterT<nds::Arm9MemoryMap> Arm9Interpreter;
+
+#define INSTRUCTION(known, prefix, insn, addr)  &Arm7Interpreter::insn_##prefix<known>,
+    template <>
+    const Arm7Interpreter::InterpretedFunction Arm7Interpreter::insnTable[] =
+    {
+#include <Core/CpuTablesARM7TDMI.inl>
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  &Arm7Interpreter::thumb_##prefix<known>,
+    template <>
+    const Arm7Interpreter::InterpretedFunction Arm7Interpreter::thumbTable[] =
+    {
+#include <Core/CpuTablesThumbARM7TDMI.inl>
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  &Arm9Interpreter::insn_##prefix<known>,
+    template <>
+    const Arm9Interpreter::InterpretedFunction Arm9Interpreter::insnTable[] =
+    {
+#include <Core/CpuTablesARM946ES.inl>
+    };
+#undef INSTRUCTION
+
+#define INSTRUCTION(known, prefix, insn, addr)  &Arm9Interpreter::thumb_##prefix<known>,
+    template <>
+    const Arm9Interpreter::InterpretedFunction Arm9Interpreter::thumbTable[] =
+    {
+#include <Core/CpuTablesThumbARM946ES.inl>
+    };
+#undef INSTRUCTION
+
+    const uint32_t REG_IME = 0x04000208;
+    const uint32_t REG_IF = 0x04000214;
+
+    // Without IRQ dispatch no handler sets the BIOS check flags, IF stands in for them. Like the BIOS loop around
+    // its halt, the call is repeated after each wake up until one of the flags in mask is set, then acknowledges them.
+    bool intrWait(emu::CpuArm& cpu, bool discard, uint32_t mask, bool& waiting)
+    {
+        cpu.write32(REG_IME, 1);
+        if (discard && !waiting)
+            cpu.write32(REG_IF, mask);
+
+        uint32_t flags = cpu.read32(REG_IF) & mask;
+        waiting = !flags;
+        if (flags)
+        {
+            cpu.write32(REG_IF, flags);
+            return true;
+        }
+        cpu.waitForInterrupt(mask);
+        return false;
+    }
+
+    // Only the BIOS calls waiting for interrupts are emulated. Returns false when the call must run again.
+    bool swiBios(emu::CpuArm& cpu, uint32_t number, bool& intrWaiting)
+    {
+        const auto& registers = cpu.getRegisters();
+        switch (number)
+        {
+        case 0x04: // IntrWait
+            return intrWait(cpu, registers.r[0] != 0, registers.r[1], intrWaiting);
+
+        case 0x05: // VBlankIntrWait
+            return intrWait(cpu, true, EMU_BIT(nds::Io::IRQ_VBLANK), intrWaiting);
+
+        case 0x06: // Halt
+            cpu.halt();
+            return true;
+
+        default:
+            EMU_NOT_IMPLEMENTED();
+            return true;
+        }
+    }
+}
+
+namespace nds
+{
+    bool Arm7Cpu::create(const Config& config, Arm7MemoryMap& memory, emu::Clock& clock, uint32_t clockDivider)
+    {
+        return emu::ARM7TDMI::create(config, memory, clock, clockDivider);
+    }
+
+    uint32_t Arm7Cpu::execute()
+    {
+        return static_cast<Arm7Interpreter*>(static_cast<CpuArm*>(this))->interpretImpl();
+    }
+
+    void Arm7Cpu::swi(uint32_t number)
+    {
+        if (!swiBios(*this, number, mIntrWaiting))
+            mPCNext = mPC;
+    }
+
+    bool Arm9Cpu::create(const Config& config, Arm9MemoryMap& memory, emu::Clock& clock, uint32_t clockDivider)
+    {
+        return emu::ARM946ES::create(config, memory, clock, clockDivider);
+    }
+
+    uint32_t Arm9Cpu::execute()
+    {
+        return static_cast<Arm9Interpreter*>(static_cast<CpuArm*>(this))->interpretImpl();
+    }
+
+    void Arm9Cpu::swi(uint32_t number)
+    {
+        if (!swiBios(*this, number, mIntrWaiting))
+            mPCNext = mPC;
+    }
+}
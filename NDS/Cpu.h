@@ -0,0 +1,37 @@
+#pragma once
+
+#include "MemoryMap.h"
+#include <Core/CpuARM7TDMI.h>
+#include <Core/CpuARM946ES.h>
+
+namespace nds
+{
+    // Interpreters specialized for the NDS memory maps so hot I/O registers inline into instruction handlers
+    class Arm7Cpu : public emu::ARM7TDMI
+    {
+    public:
+        bool create(const Config& config, Arm7MemoryMap& memory, emu::Clock& clock, uint32_t clockDivider);
+        virtual uint32_t execute() override;
+
+    protected:
+        virtual void swi(uint32_t number) override;
+
+    private:
+        // Set between the passes of an IntrWait call, only the first one discards old flags
+        bool mIntrWaiting{ false };
+    };
+
+    class Arm9Cpu : public emu::ARM946ES
+    {
+    public:
+        bool create(const Config& config, Arm9MemoryMap& memory, emu::Clock& clock, uint32_t clockDivider);
+        virtual uint32_t execute() override;
+
+    protected:
+        virtual void swi(uint32_t number) override;
+
+    private:
+        // Set between the passes of an IntrWait call, only the first one discards old flags
+        bool mIntrWaiting{ false };
+    };
+}
@@ -0,0 +1,60 @@
+#include "Display.h"
+#include "Io.h"
+
+namespace nds
+{
+    Display::Display()
+        : mScheduler(nullptr)
+        , mArm7Io(nullptr)
+        , mArm9Io(nullptr)
+        , mLine(0)
+    {
+    }
+
+    Display::~Display()
+    {
+        if (mScheduler)
+        {
+            mScheduler->cancel(mHBlankEvent);
+            mScheduler->cancel(mLineEvent);
+        }
+    }
+
+    bool Display::create(emu::Scheduler& scheduler, Io& arm7Io, Io& arm9Io)
+    {
+        mScheduler = &scheduler;
+        mArm7Io = &arm7Io;
+        mArm9Io = &arm9Io;
+        mHBlankEvent.setCallback(emu::Scheduler::Callback::make<Display, &Display::onHBlank>(this));
+        mLineEvent.setCallback(emu::Scheduler::Callback::make<Display, &Display::onLine>(this));
+        return true;
+    }
+
+    void Display::reset(emu::Tick tick)
+    {
+        mLine = 0;
+        startLine(tick);
+    }
+
+    void Display::startLine(emu::Tick tick)
+    {
+        mArm7Io->setHBlank(false);
+        mArm9Io->setHBlank(false);
+        mArm7Io->setDisplayLine(mLine);
+        mArm9Io->setDisplayLine(mLine);
+        mScheduler->schedule(mHBlankEvent, tick + DOTS_VISIBLE_H * TICKS_PER_DOT);
+        mScheduler->schedule(mLineEvent, tick + DOTS_TOTAL_H * TICKS_PER_DOT);
+    }
+
+    void Display::onHBlank(emu::Tick)
+    {
+        mArm7Io->setHBlank(true);
+        mArm9Io->setHBlank(true);
+    }
+
+    void Display::onLine(emu::Tick tick)
+    {
+        mLine = (mLine + 1 < DOTS_TOTAL_V) ? mLine + 1 : 0;
+        startLine(tick);
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "NDS.h"
+#include <Core/Scheduler.h>
+
+namespace nds
+{
+    class Io;
+
+    // Display timing runs on clock events, each line schedules its HBlank edge and the start of the next line
+    class Display
+    {
+    public:
+        Display();
+        ~Display();
+        bool create(emu::Scheduler& scheduler, Io& arm7Io, Io& arm9Io);
+        void reset(emu::Tick tick);
+
+    private:
+        static const emu::Tick  TICKS_PER_DOT = TICKS_PER_FRAME / DOTS_PER_FRAME;
+
+        void startLine(emu::Tick tick);
+        void onHBlank(emu::Tick tick);
+        void onLine(emu::Tick tick);
+
+        emu::Scheduler*         mScheduler;
+        Io*                     mArm7Io;
+        Io*                     mArm9Io;
+        emu::Scheduler::Event   mHBlankEvent;
+        emu::Scheduler::Event   mLineEvent;
+        uint32_t                mLine;
+    };
+}
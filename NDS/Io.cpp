@@ -0,0 +1,123 @@
+#include "Io.h"
+
+#define IO_REGISTER(name, addr, size, read, write)  { name, addr, size, read, write },
+#define IO_READ(name)                               &IoTable::makeRead<&Io::read##name>
+#define IO_WRITE(name)                              &IoTable::makeWrite<&Io::write##name>
+
+namespace nds
+{
+    const Io::IoTable::Register Io::arm7Registers[] =
+    {
+        IO_REGISTER("DISPSTAT", 0x04000004, 2, IO_READ(DISPSTAT),   IO_WRITE(DISPSTAT))
+        IO_REGISTER("VCOUNT",   0x04000006, 2, IO_READ(VCOUNT),     nullptr)
+        IO_REGISTER("IPCSYNC",  0x04000180, 2, IO_READ(IPCSYNC),    IO_WRITE(IPCSYNC))
+        IO_REGISTER("IME",      0x04000208, 4, IO_READ(IME),        IO_WRITE(IME))
+        IO_REGISTER("IE",       0x04000210, 4, IO_READ(IE),         IO_WRITE(IE))
+        IO_REGISTER("IF",       0x04000214, 4, IO_READ(IF),         IO_WRITE(IF))
+        IO_REGISTER("POSTFLG",  0x04000300, 1, IO_READ(POSTFLG),    IO_WRITE(POSTFLG))
+        IO_REGISTER("HALTCNT",  0x04000301, 1, nullptr,             IO_WRITE(HALTCNT))
+    };
+
+    const Io::IoTable::Register Io::arm9Registers[] =
+    {
+        IO_REGISTER("DISPSTAT", 0x04000004, 2, IO_READ(DISPSTAT),   IO_WRITE(DISPSTAT))
+        IO_REGISTER("VCOUNT",   0x04000006, 2, IO_READ(VCOUNT),     nullptr)
+        IO_REGISTER("IPCSYNC",  0x04000180, 2, IO_READ(IPCSYNC),    IO_WRITE(IPCSYNC))
+        IO_REGISTER("IME",      0x04000208, 4, IO_READ(IME),        IO_WRITE(IME))
+        IO_REGISTER("IE",       0x04000210, 4, IO_READ(IE),         IO_WRITE(IE))
+        IO_REGISTER("IF",       0x04000214, 4, IO_READ(IF),         IO_WRITE(IF))
+        IO_REGISTER("POSTFLG",  0x04000300, 1, IO_READ(POSTFLG),    IO_WRITE(POSTFLG))
+    };
+
+    Io::Io()
+        : mArm7(false)
+        , mRemote(nullptr)
+    {
+        reset();
+    }
+
+    Io::~Io()
+    {
+    }
+
+    bool Io::create(bool arm7, emu::MemoryBus32& memory, Io& remote)
+    {
+        mArm7 = arm7;
+        mRemote = &remote;
+        if (arm7)
+        {
+            EMU_VERIFY(mTable.create("ARM7 I/O", *this, IO_BASE, IO_SIZE, arm7Registers, sizeof(arm7Registers) / sizeof(arm7Registers[0])));
+        }
+        else
+        {
+            EMU_VERIFY(mTable.create("ARM9 I/O", *this, IO_BASE, IO_SIZE, arm9Registers, sizeof(arm9Registers) / sizeof(arm9Registers[0])));
+        }
+        mTable.bind(mAccessor);
+        EMU_VERIFY(memory.addRange(IO_BASE, IO_WINDOW_SIZE, mAccessor));
+        return true;
+    }
+
+    void Io::reset()
+    {
+        mDISPSTAT = 0;
+        mVCOUNT = 0;
+        mIME = 0;
+        mIE = 0;
+        mIF = 0;
+        mIPCSYNC = 0;
+        mPOSTFLG = 0;
+        mHALTCNT = 0;
+    }
+
+    void Io::setDisplayLine(uint32_t line)
+    {
+        // VBlank covers the lines after the visible ones except the last, LYC has its ninth bit in bit 7
+        uint32_t lyc = EMU_BITS_GET(8, 8, mDISPSTAT) | (EMU_BIT_GET(7, mDISPSTAT) << 8);
+        bool vblank = (line >= DOTS_VISIBLE_V) && (line < DOTS_TOTAL_V - 1);
+        bool match = line == lyc;
+        mVCOUNT = line;
+        mDISPSTAT = EMU_BITS_BLEND(mDISPSTAT, (vblank ? 0x1 : 0) | (match ? 0x4 : 0), 0x5);
+        if ((line == DOTS_VISIBLE_V) && (mDISPSTAT & 0x8))
+            requestInterrupt(IRQ_VBLANK);
+        if (match && (mDISPSTAT & 0x20))
+            requestInterrupt(IRQ_VCOUNT);
+    }
+
+    void Io::setHBlank(bool hblank)
+    {
+        mDISPSTAT = EMU_BITS_BLEND(mDISPSTAT, hblank ? 0x2 : 0, 0x2);
+        if (hblank && (mDISPSTAT & 0x10))
+            requestInterrupt(IRQ_HBLANK);
+    }
+
+    uint32_t Io::readPOSTFLG()
+    {
+        return mPOSTFLG;
+    }
+
+    void Io::writePOSTFLG(uint32_t value, uint32_t mask)
+    {
+        // Bit 0 can only be set, the ARM9 has an extra read/write bit
+        mPOSTFLG |= value & mask & 0x1;
+        if (!mArm7)
+            mPOSTFLG = EMU_BITS_BLEND(mPOSTFLG, value, mask & 0x2);
+    }
+
+    void Io::writeHALTCNT(uint32_t value, uint32_t mask)
+    {
+        mHALTCNT = EMU_BITS_BLEND(mHALTCNT, value, mask & 0xc0);
+        switch (EMU_BITS_GET(6, 2, value & mask))
+        {
+        case 0:
+            break;
+
+        case 2:
+            mHaltDelegate();
+            break;
+
+        default:
+            EMU_NOT_IMPLEMENTED();
+            break;
+        }
+    }
+}
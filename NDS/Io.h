@@ -0,0 +1,218 @@
+#pragma once
+
+#include "NDS.h"
+#include <Core/IoTable.h>
+#include <Core/MemoryBus.h>
+#include <atomic>
+
+namespace nds
+{
+    class Io
+    {
+    public:
+        static const uint32_t   IO_BASE = 0x04000000;
+        static const uint32_t   IO_SIZE = 0x2000;
+        static const uint32_t   IO_WINDOW_SIZE = 0x1000000;
+
+        static const uint32_t   IRQ_VBLANK = 0;
+        static const uint32_t   IRQ_HBLANK = 1;
+        static const uint32_t   IRQ_VCOUNT = 2;
+        static const uint32_t   IRQ_IPCSYNC = 16;
+
+        // Called before accessing registers shared with the other CPU so both stay ordered in time
+        typedef emu::Delegate<void()> SyncDelegate;
+        typedef emu::Delegate<void()> HaltDelegate;
+        // Called each time an interrupt is raised or enabled so a halted CPU waiting for it resumes
+        typedef emu::Delegate<void()> WakeDelegate;
+
+        Io();
+        ~Io();
+        bool create(bool arm7, emu::MemoryBus32& memory, Io& remote);
+        void reset();
+        void setSyncDelegate(SyncDelegate value)
+        {
+            mSyncDelegate = value;
+        }
+
+        void setHaltDelegate(HaltDelegate value)
+        {
+            mHaltDelegate = value;
+        }
+
+        void setWakeDelegate(WakeDelegate value)
+        {
+            mWakeDelegate = value;
+        }
+
+        // Halted CPUs resume as soon as an enabled interrupt is raised, even when IME masks it
+        uint32_t getPendingInterrupts()
+        {
+            return mIE.load(std::memory_order_relaxed) & mIF.load(std::memory_order_relaxed);
+        }
+
+        // The remote CPU raises interrupts from its own thread when the clock is threaded
+        void requestInterrupt(uint32_t irq)
+        {
+            mIF.fetch_or(EMU_BIT(irq), std::memory_order_relaxed);
+            mWakeDelegate();
+        }
+
+        // Display timing edges, both CPUs see the same lines with their own DISPSTAT interrupt settings
+        void setDisplayLine(uint32_t line);
+        void setHBlank(bool hblank);
+
+        const emu::MemoryBus32::Accessor& getAccessor() const
+        {
+            return mAccessor;
+        }
+
+        // Hot registers accessed at their base address are handled inline, false means the access must go through the table
+        template <typename T>
+        bool readHot(uint32_t addr, T& value)
+        {
+            switch (addr)
+            {
+            case 0x04000180:
+                if (sizeof(T) > 2)
+                    return false;
+                value = static_cast<T>(readIPCSYNC());
+                return true;
+
+            case 0x04000208:
+                value = static_cast<T>(readIME());
+                return true;
+
+            case 0x04000210:
+                value = static_cast<T>(readIE());
+                return true;
+
+            case 0x04000214:
+                value = static_cast<T>(readIF());
+                return true;
+
+            default:
+                return false;
+            }
+        }
+
+        template <typename T>
+        bool writeHot(uint32_t addr, T value)
+        {
+            uint32_t mask = (sizeof(T) >= 4) ? ~0u : ((1u << (8 * sizeof(T))) - 1);
+            switch (addr)
+            {
+            case 0x04000180:
+                if (sizeof(T) > 2)
+                    return false;
+                writeIPCSYNC(value, mask);
+                return true;
+
+            case 0x04000208:
+                writeIME(value, mask);
+                return true;
+
+            case 0x04000210:
+                writeIE(value, mask);
+                return true;
+
+            case 0x04000214:
+                writeIF(value, mask);
+                return true;
+
+            default:
+                return false;
+            }
+        }
+
+    private:
+        typedef emu::IoTableT<Io> IoTable;
+
+        static const IoTable::Register arm7Registers[];
+        static const IoTable::Register arm9Registers[];
+
+        uint32_t readIME()
+        {
+            return mIME;
+        }
+
+        void writeIME(uint32_t value, uint32_t mask)
+        {
+            mIME = EMU_BITS_BLEND(mIME, value, mask & 0x1);
+        }
+
+        uint32_t readIE()
+        {
+            return mIE.load(std::memory_order_relaxed);
+        }
+
+        void writeIE(uint32_t value, uint32_t mask)
+        {
+            mIE.store(EMU_BITS_BLEND(mIE.load(std::memory_order_relaxed), value, mask), std::memory_order_relaxed);
+            mWakeDelegate();
+        }
+
+        uint32_t readIF()
+        {
+            return mIF.load(std::memory_order_relaxed);
+        }
+
+        void writeIF(uint32_t value, uint32_t mask)
+        {
+            // Interrupts are acknowledged by writing 1 to their bit
+            mIF.fetch_and(~(value & mask), std::memory_order_relaxed);
+        }
+
+        uint32_t readIPCSYNC()
+        {
+            // Input bits mirror the output bits of the other CPU
+            mSyncDelegate();
+            uint32_t remote = mRemote->mIPCSYNC.load(std::memory_order_acquire);
+            return (mIPCSYNC.load(std::memory_order_relaxed) & 0x4f00) | ((remote >> 8) & 0xf);
+        }
+
+        void writeIPCSYNC(uint32_t value, uint32_t mask)
+        {
+            mSyncDelegate();
+            uint32_t local = EMU_BITS_BLEND(mIPCSYNC.load(std::memory_order_relaxed), value, mask & 0x4f00);
+            mIPCSYNC.store(local, std::memory_order_release);
+            if ((value & mask & EMU_BIT(13)) && (mRemote->mIPCSYNC.load(std::memory_order_acquire) & EMU_BIT(14)))
+                mRemote->requestInterrupt(IRQ_IPCSYNC);
+        }
+
+        uint32_t readDISPSTAT()
+        {
+            return mDISPSTAT;
+        }
+
+        void writeDISPSTAT(uint32_t value, uint32_t mask)
+        {
+            // Blanking and match flags are read only
+            mDISPSTAT = EMU_BITS_BLEND(mDISPSTAT, value, mask & 0xffb8);
+        }
+
+        uint32_t readVCOUNT()
+        {
+            return mVCOUNT;
+        }
+
+        uint32_t readPOSTFLG();
+        void writePOSTFLG(uint32_t value, uint32_t mask);
+        void writeHALTCNT(uint32_t value, uint32_t mask);
+
+        bool                            mArm7;
+        Io*                             mRemote;
+        IoTable                         mTable;
+        emu::MemoryBus32::Accessor      mAccessor;
+        SyncDelegate                    mSyncDelegate;
+        HaltDelegate                    mHaltDelegate;
+        WakeDelegate                    mWakeDelegate;
+        uint32_t                        mDISPSTAT;
+        uint32_t                        mVCOUNT;
+        uint32_t                        mIME;
+        std::atomic<uint32_t>           mIE;
+        std::atomic<uint32_t>           mIF;
+        std::atomic<uint32_t>           mIPCSYNC;
+        uint32_t                        mPOSTFLG;
+        uint32_t                        mHALTCNT;
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Io.h"
+#include <Core/MemoryMap.h>
+
+namespace nds
+{
+    struct IoRegion
+    {
+        static const uint32_t   FIRST = 0x04;
+        static const uint32_t   LAST = 0x04;
+
+        template <typename T>
+        T readTimed(emu::MemoryBus32& bus, uint32_t addr, uint32_t& cycles, bool sequential)
+        {
+            // Pages with a watch trap take the bus path so watchpoints still see the access
+            T value;
+            if (!bus.getTraps(addr) && mIo->readHot(addr, value))
+            {
+                const auto& accessor = mIo->getAccessor();
+                EMU_MEMORY_STATS(emu::MemoryStats::countRead<T>(accessor.statsIndex, true));
+                cycles += accessor.timing.get<T>(sequential);
+                return value;
+            }
+            return bus.readTimed<T>(addr, cycles, sequential);
+        }
+
+        template <typename T>
+        void writeTimed(emu::MemoryBus32& bus, uint32_t addr, T value, uint32_t& cycles, bool sequential)
+        {
+            if (!bus.getTraps(addr) && mIo->writeHot(addr, value))
+            {
+                const auto& accessor = mIo->getAccessor();
+                EMU_MEMORY_STATS(emu::MemoryStats::countWrite<T>(accessor.statsIndex, true));
+                cycles += accessor.timing.get<T>(sequential);
+                return;
+            }
+            bus.writeTimed<T>(addr, value, cycles, sequential);
+        }
+
+        Io*                     mIo{ nullptr };
+    };
+
+    // Main RAM and every other region use the runtime bus fast page table, which is already a single inline lookup.
+    // Each CPU has its own map type so the interpreters specialized on them stay distinct.
+    class Arm7MemoryMap : public emu::MemoryMapT<IoRegion>
+    {
+    };
+
+    class Arm9MemoryMap : public emu::MemoryMapT<IoRegion>
+    {
+    };
+}
@@ -1,7 +1,10 @@
 #include <Core/Clock.h>
-#include <Core/CpuARM7TDMI.h>
-#include <Core/CpuARM946ES.h>
 #include <Core/MemoryBus.h>
+#include <Core/MemoryStats.h>
+#include "Cpu.h"
+#include "Display.h"
+#include "Io.h"
+#include "MemoryMap.h"
 #include "Rom.h"
 #include <memory>
 
@@ -19,18 +22,44 @@ namespace
             const auto& header = mROM.getHeader();
 
             mMainRAM.resize(MAIN_RAM_SIZE);
-            mAccessorMainRAM.setName("Main RAM").setMemoryWritable(mMainRAM.data());
-
-            EMU_VERIFY(mClock.create());
+            // Main RAM is 16-bit wide, both CPUs see it with their own waitstates and share its dirty pages
+            EMU_VERIFY(mMainRAMTracker.create(MAIN_RAM_SIZE));
+            mAccessorArm7MainRAM.setName("Main RAM").setMemoryWritable(mMainRAM.data()).setDirtyTracker(mMainRAMTracker)
+                .setTiming(8, 8, 1).setTiming(16, 8, 1).setTiming(32, 9, 2);
+            mAccessorArm9MainRAM.setName("Main RAM").setMemoryWritable(mMainRAM.data()).setDirtyTracker(mMainRAMTracker)
+                .setTiming(8, 18, 2).setTiming(16, 18, 2).setTiming(32, 20, 4);
+
+            Clock::Config clockConfig;
+            clockConfig.threaded = EMU_CONFIG_THREADED_CLOCK != 0;
+            clockConfig.maxSkew = ARM9_TICKS_PER_DOT * DOTS_TOTAL_H;
+            clockConfig.minQuantum = ARM9_TICKS_PER_DOT * 16;
+            clockConfig.maxQuantum = ARM9_TICKS_PER_DOT * DOTS_TOTAL_H * 16;
+            EMU_VERIFY(mClock.create(clockConfig));
 
             EMU_VERIFY(mArm7Memory.create(28, 23));
-            EMU_VERIFY(mArm7Memory.addRange(0x02000000, MAIN_RAM_SIZE, mAccessorMainRAM));
+            EMU_VERIFY(mArm7Memory.addMirroredRange(0x02000000, MAIN_RAM_WINDOW_SIZE, MAIN_RAM_SIZE - 1, mAccessorArm7MainRAM));
 
             EMU_VERIFY(mArm9Memory.create(28, 22));
-            EMU_VERIFY(mArm9Memory.addRange(0x02000000, MAIN_RAM_SIZE, mAccessorMainRAM));
-
-            EMU_VERIFY(mArm7Cpu.create(CpuArm::Config(), mArm7Memory, mClock, TICKS_PER_FRAME / ARM7_TICKS_PER_FRAME));
-            EMU_VERIFY(mArm9Cpu.create(CpuArm::Config(), mArm9Memory, mClock, TICKS_PER_FRAME / ARM7_TICKS_PER_FRAME));
+            EMU_VERIFY(mArm9Memory.addMirroredRange(0x02000000, MAIN_RAM_WINDOW_SIZE, MAIN_RAM_SIZE - 1, mAccessorArm9MainRAM));
+
+            EMU_VERIFY(mArm7Io.create(true, mArm7Memory, mArm9Io));
+            EMU_VERIFY(mArm9Io.create(false, mArm9Memory, mArm7Io));
+            mArm7Memory.getRegion<IoRegion>().mIo = &mArm7Io;
+            mArm9Memory.getRegion<IoRegion>().mIo = &mArm9Io;
+            EMU_VERIFY(mDisplay.create(mClock.getScheduler(), mArm7Io, mArm9Io));
+
+            CpuArm::Config cpuConfig;
+            cpuConfig.cacheBlocks = true;
+            cpuConfig.jit = true;
+            EMU_VERIFY(mArm7Cpu.create(cpuConfig, mArm7Memory, mClock, TICKS_PER_FRAME / ARM7_TICKS_PER_FRAME));
+            EMU_VERIFY(mArm9Cpu.create(cpuConfig, mArm9Memory, mClock, TICKS_PER_FRAME / ARM9_TICKS_PER_FRAME));
+            mArm7Io.setSyncDelegate(Io::SyncDelegate::make<CpuArm, &CpuArm::synchronize>(&mArm7Cpu));
+            mArm9Io.setSyncDelegate(Io::SyncDelegate::make<CpuArm, &CpuArm::synchronize>(&mArm9Cpu));
+            mArm7Io.setHaltDelegate(Io::HaltDelegate::make<CpuArm, &CpuArm::halt>(&mArm7Cpu));
+            mArm7Io.setWakeDelegate(Io::WakeDelegate::make<CpuArm, &CpuArm::wake>(&mArm7Cpu));
+            mArm9Io.setWakeDelegate(Io::WakeDelegate::make<CpuArm, &CpuArm::wake>(&mArm9Cpu));
+            mArm7Cpu.setInterruptDelegate(CpuArm::InterruptDelegate::make<Io, &Io::getPendingInterrupts>(&mArm7Io));
+            mArm9Cpu.setInterruptDelegate(CpuArm::InterruptDelegate::make<Io, &Io::getPendingInterrupts>(&mArm9Io));
 
             // Load startup code into RAM
             mArm7Memory.write(header.ARM7RAMAddress, reinterpret_cast<const uint32_t*>(mROM.getContent().data() + header.ARM7ROMOffset), divideUp(header.ARM7Size, 4));
@@ -44,6 +73,9 @@ namespace
         void reset()
         {
             const auto& header = mROM.getHeader();
+            mArm7Io.reset();
+            mArm9Io.reset();
+            mDisplay.reset(mClock.getExecutedTick());
             mArm7Cpu.reset();
             mArm7Cpu.setPC(header.ARM7EntryAddress);
             mArm9Cpu.reset();
@@ -52,19 +84,35 @@ namespace
 
         void executeFrame()
         {
-            mClock.execute(TICKS_PER_FRAME);
-            mClock.advance(TICKS_PER_FRAME);
+            mFrameEndTick += TICKS_PER_FRAME;
+            mClock.execute(mFrameEndTick);
+
+#if EMU_CONFIG_MEMORY_STATS
+            // Counters are cumulative, each frame reports the difference with the previous one
+            mMemoryStats[0].entries.swap(mMemoryStats[1].entries);
+            MemoryStats::capture(mMemoryStats[0]);
+            MemoryStats::dump(mMemoryStats[0], mMemoryStats[1]);
+#endif
         }
 
     private:
         Rom                     mROM;
         std::vector<uint8_t>    mMainRAM;
+        MemoryBus32::DirtyTracker mMainRAMTracker;
         Clock                   mClock;
-        MemoryBus32             mArm7Memory;
-        MemoryBus32             mArm9Memory;
-        MemoryBus32::Accessor   mAccessorMainRAM;
-        ARM7TDMI                mArm7Cpu;
-        ARM946ES                mArm9Cpu;
+        Tick                    mFrameEndTick = 0;
+        Arm7MemoryMap           mArm7Memory;
+        Arm9MemoryMap           mArm9Memory;
+        MemoryBus32::Accessor   mAccessorArm7MainRAM;
+        MemoryBus32::Accessor   mAccessorArm9MainRAM;
+        Io                      mArm7Io;
+        Io                      mArm9Io;
+        Display                 mDisplay;
+        Arm7Cpu                 mArm7Cpu;
+        Arm9Cpu                 mArm9Cpu;
+#if EMU_CONFIG_MEMORY_STATS
+        MemoryStats::Snapshot   mMemoryStats[2];
+#endif
     };
 
     class System : public ISystem
@@ -30,6 +30,7 @@ namespace nds
     static const uint32_t   TICKS_PER_SEC = TICKS_PER_FRAME * FRAMES_PER_SEC;
 
     static const uint32_t   MAIN_RAM_SIZE = 0x400000;
+    static const uint32_t   MAIN_RAM_WINDOW_SIZE = 0x1000000;
 
     emu::ISystem& getSystem();
 }
@@ -0,0 +1,385 @@
+#include <Core/Clock.h>
+#include <Core/CpuARM946ES.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace emu;
+
+    const uint32_t  RAM_BASE = 0x02000000;
+    const uint32_t  RAM_SIZE = 0x400000;
+    const uint32_t  DATA_OFFSET = 0x1000;
+    const uint32_t  DATA_SIZE = 0x2000;
+    const uint32_t  DEVICE_BASE = 0x04000000;
+    const uint32_t  DEVICE_SIZE = 0x1000;
+    const uint32_t  DEVICE_REG_COUNT = 64;
+    const uint32_t  DEVICE_HALT = 0x20;
+    const uint32_t  PROGRAM_END = 0xef000000;
+    const uint32_t  BRANCH_SELF = 0xeafffffe;
+
+    // Registers of a device accessed through the bus slow path. Reads mix in the guest registers the callbacks
+    // see, writes to the halt register stop the CPU and the wake up records the registers the CPU stopped with.
+    class Device
+    {
+    public:
+        void create(CpuArm& cpu)
+        {
+            mCpu = &cpu;
+            memset(mRegs, 0, sizeof(mRegs));
+            mCounter = 0;
+            mWakeHash = 0;
+        }
+
+        uint8_t read8(uint32_t addr)
+        {
+            return static_cast<uint8_t>(read32(addr) >> ((addr & 3) * 8));
+        }
+
+        uint32_t read32(uint32_t addr)
+        {
+            return mRegs[getIndex(addr)] ^ hashRegisters() ^ mCounter++;
+        }
+
+        void write8(uint32_t addr, uint8_t value)
+        {
+            write32(addr, static_cast<uint32_t>(value) << ((addr & 3) * 8));
+        }
+
+        void write32(uint32_t addr, uint32_t value)
+        {
+            mRegs[getIndex(addr)] ^= value ^ mCounter++;
+            if ((addr & ~0x3u) == DEVICE_BASE + DEVICE_HALT)
+                mCpu->halt();
+        }
+
+        uint32_t getPendingInterrupts()
+        {
+            mWakeHash = (mWakeHash * 31) ^ hashRegisters();
+            return 1;
+        }
+
+        bool operator==(const Device& other) const
+        {
+            return !memcmp(mRegs, other.mRegs, sizeof(mRegs)) && (mCounter == other.mCounter) && (mWakeHash == other.mWakeHash);
+        }
+
+    private:
+        static uint32_t getIndex(uint32_t addr)
+        {
+            return ((addr - DEVICE_BASE) >> 2) & (DEVICE_REG_COUNT - 1);
+        }
+
+        uint32_t hashRegisters() const
+        {
+            uint32_t hash = 2166136261u;
+            for (auto value : mCpu->getRegisters().r)
+                hash = (hash ^ value) * 16777619u;
+            return hash;
+        }
+
+        CpuArm*     mCpu{ nullptr };
+        uint32_t    mRegs[DEVICE_REG_COUNT];
+        uint32_t    mCounter{ 0 };
+        uint32_t    mWakeHash{ 0 };
+    };
+
+    // Programs end with a SWI, the cycle count is taken there
+    class TestCpu : public ARM946ES
+    {
+    public:
+        int64_t getExecutedCycles() const
+        {
+            return mExecutedCycles;
+        }
+
+        int64_t getEndCycles() const
+        {
+            return mEndCycles;
+        }
+
+    protected:
+        virtual void swi(uint32_t) override
+        {
+            if (mEndCycles < 0)
+                mEndCycles = mExecutedCycles + mAccessCycles;
+        }
+
+    private:
+        int64_t     mEndCycles{ -1 };
+    };
+
+    // Where a slice stopped and the flags the guest could observe there
+    struct SliceEnd
+    {
+        int64_t     cycles;
+        uint32_t    pc;
+        uint8_t     flags[4];
+    };
+
+    struct State
+    {
+        uint32_t                r[15];
+        uint8_t                 flags[4];
+        int64_t                 cycles;
+        std::vector<uint8_t>    data;
+        Device                  device;
+        std::vector<SliceEnd>   slices;
+
+        bool operator==(const State& other) const
+        {
+            return !memcmp(r, other.r, sizeof(r)) && !memcmp(flags, other.flags, sizeof(flags)) && (cycles == other.cycles) &&
+                (data == other.data) && (device == other.device);
+        }
+    };
+
+    // Runs random ARM programs with the plain interpreter, the block cache and the JIT and reports any
+    // difference in registers, flags, RAM, device state or cycle count
+    class Application
+    {
+    public:
+        struct Config
+        {
+            uint32_t    programCount{ 3000 };
+            uint32_t    programSize{ 40 };
+            uint32_t    firstSeed{ 0 };
+        };
+
+        enum Mode
+        {
+            MODE_INTERPRETER,
+            MODE_BLOCKS,
+            MODE_JIT,
+            MODE_COUNT,
+        };
+
+        bool run(const Config& config)
+        {
+            static const char* modeNames[MODE_COUNT] = { "interpreter", "blocks", "jit" };
+
+            uint32_t failures = 0;
+            for (uint32_t index = 0; index < config.programCount; ++index)
+            {
+                uint32_t seed = config.firstSeed + index;
+                std::vector<uint32_t> program;
+                generate(program, seed, config.programSize);
+
+                State states[MODE_COUNT];
+                for (uint32_t mode = 0; mode < MODE_COUNT; ++mode)
+                    execute(states[mode], program, seed, static_cast<Mode>(mode));
+
+                for (uint32_t mode = MODE_BLOCKS; mode < MODE_COUNT; ++mode)
+                {
+                    uint32_t staleSlices = countStaleSlices(states[MODE_INTERPRETER], states[mode]);
+                    if (staleSlices)
+                    {
+                        printf("Seed %u: %s flags differ at %u slice ends\n", seed, modeNames[mode], staleSlices);
+                        ++failures;
+                    }
+                    if (states[mode] == states[MODE_INTERPRETER])
+                        continue;
+                    printf("Seed %u: %s differs from %s\n", seed, modeNames[mode], modeNames[MODE_INTERPRETER]);
+                    dump(states[MODE_INTERPRETER], states[mode]);
+                    ++failures;
+                }
+            }
+            printf("%u programs, %u mismatches\n", config.programCount, failures);
+            return failures == 0;
+        }
+
+    private:
+        // Data processing, loads and stores on RAM and on the device, and short forward branches. Registers r0 to r9
+        // are free, r10 and r11 point to RAM data, r12 holds a small offset and r13 points to the device.
+        static void generate(std::vector<uint32_t>& program, uint32_t seed, uint32_t size)
+        {
+            std::mt19937 random(seed);
+            auto next = [&random](uint32_t range)
+            {
+                return static_cast<uint32_t>(random() % range);
+            };
+
+            program.clear();
+            for (uint32_t index = 0; index < size; ++index)
+            {
+                uint32_t kind = next(10);
+                uint32_t cond = next(8) ? 0xe : next(15);
+                if (kind < 6)
+                {
+                    uint32_t op = next(16);
+                    uint32_t immediate = next(2);
+                    uint32_t setFlags = ((op >= 0x8) && (op <= 0xb)) ? 1 : next(2);
+                    uint32_t rn = next(12) ? next(10) : 15;
+                    uint32_t opcode = (cond << 28) | (immediate << 25) | (op << 21) | (setFlags << 20) | (rn << 16) | (next(10) << 12);
+                    uint32_t rm = next(12) ? next(10) : 15;
+                    if (immediate)
+                        opcode |= (next(16) << 8) | next(256);
+                    else if (!next(8))
+                        opcode |= (next(10) << 8) | (next(4) << 5) | 0x10 | rm;
+                    else
+                        opcode |= (next(32) << 7) | (next(4) << 5) | rm;
+                    program.push_back(opcode);
+                }
+                else if (kind < 9)
+                {
+                    uint32_t load = next(2);
+                    uint32_t byte = next(2);
+                    uint32_t pre = next(2);
+                    uint32_t up = next(2);
+                    uint32_t writeBack = pre ? next(2) : 0;
+                    uint32_t rn = 10 + next(2);
+                    if (!next(4))
+                    {
+                        // Literal load
+                        rn = 15;
+                        load = 1;
+                        pre = 1;
+                        up = 1;
+                        writeBack = 0;
+                    }
+                    else if (!next(3))
+                    {
+                        // The device base stays fixed
+                        rn = 13;
+                        pre = 1;
+                        up = 1;
+                        writeBack = 0;
+                    }
+                    uint32_t opcode = (cond << 28) | (1 << 26) | (pre << 24) | (up << 23) | (byte << 22) | (writeBack << 21) | (load << 20) |
+                        (rn << 16) | (next(10) << 12);
+                    if (!next(4))
+                        opcode |= (1 << 25) | (next(3) << 7) | 12;
+                    else
+                        opcode |= next(64);
+                    program.push_back(opcode);
+                }
+                else
+                {
+                    // Forward branch over up to 2 instructions
+                    uint32_t link = next(4) ? 0 : 1;
+                    program.push_back((next(15) << 28) | (5 << 25) | (link << 24) | next(3));
+                }
+            }
+            program.push_back(PROGRAM_END);
+            for (uint32_t index = 0; index < 3; ++index)
+                program.push_back(BRANCH_SELF);
+        }
+
+        static void execute(State& state, const std::vector<uint32_t>& program, uint32_t seed, Mode mode)
+        {
+            std::vector<uint8_t> ram(RAM_SIZE);
+            std::mt19937 random(seed);
+            for (uint32_t offset = DATA_OFFSET; offset < DATA_OFFSET + DATA_SIZE; ++offset)
+                ram[offset] = static_cast<uint8_t>(random());
+
+            Clock clock;
+            clock.create(Clock::Config());
+            MemoryBus32::Accessor accessorRAM;
+            MemoryBus32::Accessor accessorDevice;
+            MemoryBus32 memory;
+            TestCpu cpu;
+            Device& device = state.device;
+            device.create(cpu);
+            accessorRAM.setName("RAM").setMemoryWritable(ram.data()).setTiming(8, 2, 1).setTiming(32, 3, 1);
+            accessorDevice.setName("Device").setTiming(8, 4, 4).setTiming(32, 4, 4)
+                .setReadFunc(MemoryBus32::ReadDelegate8::make<Device, &Device::read8>(&device))
+                .setReadFunc(MemoryBus32::ReadDelegate32::make<Device, &Device::read32>(&device))
+                .setWriteFunc(MemoryBus32::WriteDelegate8::make<Device, &Device::write8>(&device))
+                .setWriteFunc(MemoryBus32::WriteDelegate32::make<Device, &Device::write32>(&device));
+            memory.create(28, 22);
+            memory.addMirroredRange(RAM_BASE, 0x1000000, RAM_SIZE - 1, accessorRAM);
+            memory.addRange(DEVICE_BASE, DEVICE_SIZE, accessorDevice);
+            memory.write(RAM_BASE, program.data(), program.size());
+
+            CpuArm::Config config;
+            config.skipIdleLoops = false;
+            config.cacheBlocks = mode != MODE_INTERPRETER;
+            config.jit = mode == MODE_JIT;
+            cpu.create(config, memory, clock, 1);
+            cpu.setInterruptDelegate(CpuArm::InterruptDelegate::make<Device, &Device::getPendingInterrupts>(&device));
+            cpu.reset();
+
+            auto& registers = const_cast<CpuArm::Registers&>(cpu.getRegisters());
+            for (uint32_t index = 0; index < 10; ++index)
+                registers.r[index] = static_cast<uint32_t>(random());
+            registers.r[10] = RAM_BASE + DATA_OFFSET + 0x400;
+            registers.r[11] = RAM_BASE + DATA_OFFSET + 0x1400;
+            registers.r[12] = 16;
+            registers.r[13] = DEVICE_BASE;
+            registers.flag_n = static_cast<uint8_t>(random() & 1);
+            registers.flag_z = static_cast<uint8_t>(random() & 1);
+            registers.flag_c = static_cast<uint8_t>(random() & 1);
+            registers.flag_v = static_cast<uint8_t>(random() & 1);
+            cpu.setPC(RAM_BASE);
+
+            // Short slices of varying length make blocks end at many different places
+            for (uint32_t slice = 1; (slice <= 4000) && (cpu.getEndCycles() < 0); ++slice)
+            {
+                clock.execute(slice * 7);
+                SliceEnd end = { cpu.getExecutedCycles(), registers.r[15],
+                    { registers.flag_n, registers.flag_z, registers.flag_c, registers.flag_v } };
+                state.slices.push_back(end);
+            }
+
+            memcpy(state.r, registers.r, sizeof(state.r));
+            state.flags[0] = registers.flag_n;
+            state.flags[1] = registers.flag_z;
+            state.flags[2] = registers.flag_c;
+            state.flags[3] = registers.flag_v;
+            state.cycles = cpu.getEndCycles();
+            state.data.assign(ram.begin() + DATA_OFFSET, ram.begin() + DATA_OFFSET + DATA_SIZE);
+        }
+
+        // Blocks may run past the end of a slice, only the slices ending on the same instruction are compared
+        static uint32_t countStaleSlices(const State& expected, const State& actual)
+        {
+            uint32_t count = 0;
+            size_t size = std::min(expected.slices.size(), actual.slices.size());
+            for (size_t index = 0; index < size; ++index)
+            {
+                const auto& expectedEnd = expected.slices[index];
+                const auto& actualEnd = actual.slices[index];
+                if ((expectedEnd.cycles == actualEnd.cycles) && (expectedEnd.pc == actualEnd.pc) &&
+                    memcmp(expectedEnd.flags, actualEnd.flags, sizeof(expectedEnd.flags)))
+                    ++count;
+            }
+            return count;
+        }
+
+        static void dump(const State& expected, const State& actual)
+        {
+            for (uint32_t index = 0; index < 15; ++index)
+            {
+                if (expected.r[index] != actual.r[index])
+                    printf("  r%u %08x %08x\n", index, expected.r[index], actual.r[index]);
+            }
+            if (memcmp(expected.flags, actual.flags, sizeof(expected.flags)))
+            {
+                printf("  nzcv %u%u%u%u %u%u%u%u\n", expected.flags[0], expected.flags[1], expected.flags[2], expected.flags[3],
+                    actual.flags[0], actual.flags[1], actual.flags[2], actual.flags[3]);
+            }
+            if (expected.cycles != actual.cycles)
+                printf("  cycles %lld %lld\n", static_cast<long long>(expected.cycles), static_cast<long long>(actual.cycles));
+            if (expected.data != actual.data)
+                printf("  RAM differs\n");
+            if (!(expected.device == actual.device))
+                printf("  device differs\n");
+        }
+    };
+}
+
+int main(int argc, char** argv)
+{
+    Application::Config config;
+    if (argc > 1)
+        config.programCount = static_cast<uint32_t>(atoi(argv[1]));
+    if (argc > 2)
+        config.firstSeed = static_cast<uint32_t>(atoi(argv[2]));
+
+    Application application;
+    bool success = application.run(config);
+    return success ? 0 : 1;
+}
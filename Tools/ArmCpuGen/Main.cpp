@@ -21,6 +21,20 @@ namespace
         std::transform(value.begin(), value.end(), value.begin(), [](char value) { return static_cast<char>(tolower(value)); });
     }
 
+    // Mnemonics that collide with C++ alternative operator tokens get a trailing underscore
+    void toSymbol(std::string& value)
+    {
+        static const char* reserved[] = { "and", "or", "not", "xor", "bitand", "bitor", "compl" };
+        for (auto name : reserved)
+        {
+            if (value == name)
+            {
+                value += '_';
+                break;
+            }
+        }
+    }
+
     void format(std::string& dest, const char* format, ...)
     {
         char buffer[1024];
@@ -158,11 +172,13 @@ namespace ARM
     class Shared
     {
     public:
-        Shared()
+        // Symbols of each instruction set are exported separately, the prefix keeps their names apart
+        Shared(const std::string& prefix = "")
+            : mPrefix(prefix)
         {
             mInsn.add("invalid");
-            mAddrEnum.add("Invalid");
-            mAddr.add("Invalid");
+            mAddrEnum.add(prefix + "Invalid");
+            mAddr.add(prefix + "Invalid");
             mVariant.add("OP_UND");
             mName.push_back("???");
             mSuffix.push_back("");
@@ -217,7 +233,7 @@ namespace ARM
         {
             auto file = FileWriter(filename);
 
-            file.printf("\nenum class Insn : uint8_t\n{\n");
+            file.printf("\nenum class %sInsn : uint8_t\n{\n", mPrefix.c_str());
             {
                 CompactListWriter listWriter(file, 12, 1);
                 for (const auto& value : mInsn.list)
@@ -225,7 +241,7 @@ namespace ARM
             }
             file.printf("};\n");
 
-            file.printf("\nenum class Addr : uint8_t\n{\n");
+            file.printf("\nenum class %sAddr : uint8_t\n{\n", mPrefix.c_str());
             {
                 CompactListWriter listWriter(file, 16, 1);
                 for (const auto& value : mAddrEnum.list)
@@ -238,7 +254,7 @@ namespace ARM
         {
             auto file = FileWriter(filename);
 
-            file.printf("\nstatic const char* InsnName[] =\n{\n");
+            file.printf("\nstatic const char* %sInsnName[] =\n{\n", mPrefix.c_str());
             {
                 CompactListWriter listWriter(file, 12, 1);
                 for (const auto& value : mName)
@@ -246,7 +262,7 @@ namespace ARM
             }
             file.printf("};\n");
 
-            file.printf("\nstatic const char* InsnSuffix[] =\n{\n");
+            file.printf("\nstatic const char* %sInsnSuffix[] =\n{\n", mPrefix.c_str());
             {
                 CompactListWriter listWriter(file, 12, 1);
                 for (const auto& value : mSuffix)
@@ -256,6 +272,7 @@ namespace ARM
         }
 
     private:
+        std::string                 mPrefix;
         Dictionary                  mInsn;
         Dictionary                  mAddrEnum;
         Dictionary                  mAddr;
@@ -314,6 +331,7 @@ namespace ARM
 
             std::string function = insn.name + insn.suffix;
             toLower(function);
+            toSymbol(function);
             mShared.addInstruction(function, insn.name, insn.suffix, addr, variant);
 
             if (insn.opcode > static_cast<uint32_t>(mVariantTable.size()))
@@ -867,6 +885,244 @@ namespace ARM
         std::vector<std::string>    mAddrTable;
         std::vector<std::string>    mVariantTable;
     };
+
+    // Thumb opcodes are keyed on their top 10 bits. Handlers are named after the variant since the same mnemonic
+    // covers several encodings.
+    class ThumbGenerator
+    {
+    public:
+        typedef Generator::Instruction Instruction;
+
+        ThumbGenerator(Shared& shared, Family family)
+            : mShared(shared)
+            , ARMv5(false)
+        {
+            switch (family)
+            {
+            case Family::ARM7TDMI: break;
+            case Family::ARM946ES: ARMv5 = true; break;
+            }
+        }
+
+        void setInstruction(const Instruction& insn)
+        {
+            assert(!insn.addr.empty());
+            std::string addr = "Thumb" + insn.addr;
+            std::string variant = "OP_" + insn.variant;
+
+            std::string prefix = insn.variant;
+            toLower(prefix);
+
+            std::string function = insn.name;
+            toLower(function);
+            toSymbol(function);
+            mShared.addInstruction(function, insn.name, "", addr, variant);
+
+            if (insn.opcode >= static_cast<uint32_t>(mVariantTable.size()))
+            {
+                printf("Invalid opcode 0x%03x, can't not exceeed 0x%03x\n", insn.opcode, static_cast<uint32_t>(mVariantTable.size() - 1));
+                assert(false);
+            }
+            if (mVariantTable[insn.opcode] != "OP_UND")
+            {
+                printf("Can't assign %s to entry 0x%03x, %s already defined\n", variant.c_str(), insn.opcode, mVariantTable[insn.opcode].c_str());
+                assert(false);
+            }
+            mPrefixTable[insn.opcode] = prefix;
+            mInsnTable[insn.opcode] = function;
+            mAddrTable[insn.opcode] = addr;
+            mVariantTable[insn.opcode] = variant;
+        }
+
+        void setRange(uint32_t first, uint32_t count, const std::string& variant, const std::string& name, const std::string& addr)
+        {
+            for (uint32_t index = 0; index < count; ++index)
+                setInstruction(Instruction(first + index, variant, name, addr));
+        }
+
+        void genOpcodes_ShiftImm()
+        {
+            static const char* opInsn[3] = { "LSL", "LSR", "ASR" };
+            for (uint32_t op = 0; op < 3; ++op)
+                setRange(0x000 | (op << 5), 32, std::string(opInsn[op]) + "_IMM", opInsn[op], "ShiftImm");
+        }
+
+        void genOpcodes_AddSub()
+        {
+            for (uint32_t i = 0; i < 2; ++i)
+            {
+                for (uint32_t op = 0; op < 2; ++op)
+                {
+                    std::string name = op ? "SUB" : "ADD";
+                    setRange(0x060 | (i << 4) | (op << 3), 8, name + (i ? "_IMM3" : "_REG"), name, i ? "AddSubImm" : "AddSubReg");
+                }
+            }
+        }
+
+        void genOpcodes_Imm8()
+        {
+            static const char* opInsn[4] = { "MOV", "CMP", "ADD", "SUB" };
+            for (uint32_t op = 0; op < 4; ++op)
+                setRange(0x080 | (op << 5), 32, std::string(opInsn[op]) + "_IMM8", opInsn[op], "Imm8");
+        }
+
+        void genOpcodes_ALU()
+        {
+            static const char* opInsn[16] =
+            {
+                "AND", "EOR", "LSL", "LSR",
+                "ASR", "ADC", "SBC", "ROR",
+                "TST", "NEG", "CMP", "CMN",
+                "ORR", "MUL", "BIC", "MVN",
+            };
+            for (uint32_t op = 0; op < 16; ++op)
+            {
+                // Shifts and compares also have immediate forms
+                std::string variant = opInsn[op];
+                if (((op >= 0x2) && (op <= 0x4)) || (op == 0xa))
+                    variant += "_REG";
+                setInstruction(Instruction(0x100 | op, variant, opInsn[op], "AluReg"));
+            }
+        }
+
+        void genOpcodes_HiReg()
+        {
+            static const char* opInsn[3] = { "ADD", "CMP", "MOV" };
+            for (uint32_t op = 0; op < 3; ++op)
+                setRange(0x110 | (op << 2), 4, std::string(opInsn[op]) + "_HI", opInsn[op], "HiReg");
+            setRange(0x11c, 2, "BX", "BX", "BranchReg");
+            if (ARMv5)
+                setRange(0x11e, 2, "BLX_REG", "BLX", "BranchReg");
+        }
+
+        void genOpcodes_LoadPC()
+        {
+            setRange(0x120, 32, "LDR_PC", "LDR", "LoadPC");
+        }
+
+        void genOpcodes_MemReg()
+        {
+            static const char* opInsn[8] = { "STR", "STRB", "LDR", "LDRB", "STRH", "LDSB", "LDRH", "LDSH" };
+            static const char* opVariant[8] = { "STR", "STRB", "LDR", "LDRB", "STRH", "LDRSB", "LDRH", "LDRSH" };
+            for (uint32_t op = 0; op < 8; ++op)
+            {
+                uint32_t sign = op >> 2;
+                uint32_t lb = op & 3;
+                setRange(0x140 | (lb << 4) | (sign << 3), 8, std::string(opVariant[op]) + "_REG", opInsn[op], "MemReg");
+            }
+        }
+
+        void genOpcodes_MemImm()
+        {
+            for (uint32_t b = 0; b < 2; ++b)
+            {
+                for (uint32_t l = 0; l < 2; ++l)
+                {
+                    std::string name = l ? "LDR" : "STR";
+                    name += b ? "B" : "";
+                    setRange(0x180 | (b << 6) | (l << 5), 32, name + "_IMM", name, b ? "MemImm<1>" : "MemImm<4>");
+                }
+            }
+            for (uint32_t l = 0; l < 2; ++l)
+            {
+                std::string name = l ? "LDRH" : "STRH";
+                setRange(0x200 | (l << 5), 32, name + "_IMM", name, "MemImm<2>");
+            }
+        }
+
+        void genOpcodes_MemSP()
+        {
+            for (uint32_t l = 0; l < 2; ++l)
+            {
+                std::string name = l ? "LDR" : "STR";
+                setRange(0x240 | (l << 5), 32, name + "_SP", name, "MemSP");
+            }
+        }
+
+        void genOpcodes_AddPCSP()
+        {
+            setRange(0x280, 32, "ADD_PC", "ADD", "AddPC");
+            setRange(0x2a0, 32, "ADD_SP", "ADD", "AddSP");
+        }
+
+        void genOpcodes_Misc()
+        {
+            setRange(0x2c0, 2, "ADD_SP_IMM7", "ADD", "AdjustSP");
+            setRange(0x2c2, 2, "SUB_SP_IMM7", "SUB", "AdjustSP");
+            setRange(0x2d0, 4, "PUSH", "PUSH", "PushPop");
+            setRange(0x2d4, 4, "PUSH_LR", "PUSH", "PushPop");
+            setRange(0x2f0, 4, "POP", "POP", "PushPop");
+            setRange(0x2f4, 4, ARMv5 ? "POP_PC_BX" : "POP_PC", "POP", "PushPop");
+            if (ARMv5)
+                setRange(0x2f8, 4, "BKPT", "BKPT", "BKPT");
+        }
+
+        void genOpcodes_MemBlock()
+        {
+            setRange(0x300, 32, "STMIA", "STMIA", "MemBlock");
+            setRange(0x320, 32, "LDMIA", "LDMIA", "MemBlock");
+        }
+
+        void genOpcodes_Branch()
+        {
+            for (uint32_t cond = 0; cond < 14; ++cond)
+                setRange(0x340 | (cond << 2), 4, "B_COND", "B", "BranchCond");
+            setRange(0x37c, 4, "SWI", "SWI", "SWI");
+            setRange(0x380, 32, "B", "B", "Branch");
+            if (ARMv5)
+                setRange(0x3a0, 32, "BLX_SUFFIX", "BLX", "BranchLinkSuffix");
+            setRange(0x3c0, 32, "BL_PREFIX", "BL", "BranchLinkPrefix");
+            setRange(0x3e0, 32, "BL_SUFFIX", "BL", "BranchLinkSuffix");
+        }
+
+        void genOpcodes()
+        {
+            static const size_t tableSize = 1024;
+            mPrefixTable.resize(tableSize, "invalid");
+            mInsnTable.resize(tableSize, "invalid");
+            mAddrTable.resize(tableSize, "ThumbInvalid");
+            mVariantTable.resize(tableSize, "OP_UND");
+
+            genOpcodes_ShiftImm();
+            genOpcodes_AddSub();
+            genOpcodes_Imm8();
+            genOpcodes_ALU();
+            genOpcodes_HiReg();
+            genOpcodes_LoadPC();
+            genOpcodes_MemReg();
+            genOpcodes_MemImm();
+            genOpcodes_MemSP();
+            genOpcodes_AddPCSP();
+            genOpcodes_Misc();
+            genOpcodes_MemBlock();
+            genOpcodes_Branch();
+        }
+
+        void generate()
+        {
+            genOpcodes();
+        }
+
+        void exportTables(const char* filename)
+        {
+            auto file = FileWriter(filename);
+
+            file.printf("\n");
+            for (size_t index = 0; index < mInsnTable.size(); ++index)
+            {
+                uint32_t knownBits = static_cast<uint32_t>(index << 6);
+                file.printf("INSTRUCTION(0x%04x, %-12s %-8s (%s))\n", knownBits, (mPrefixTable[index] + ",").c_str(), (mInsnTable[index] + ",").c_str(), mAddrTable[index].c_str());
+            }
+        }
+
+    private:
+        bool                        ARMv5;
+        Shared&                     mShared;
+        std::vector<std::string>    mPrefixTable;
+        std::vector<std::string>    mInsnTable;
+        std::vector<std::string>    mAddrTable;
+        std::vector<std::string>    mVariantTable;
+    };
 }
 
 bool assertSame(const std::vector<std::string>& expected, const std::vector<std::string>& result)
@@ -923,5 +1179,18 @@ int main()
     generatorARM7.exportTables("CpuTablesARM7TDMI.inl");
     generatorARM9.exportTables("CpuTablesARM946ES.inl");
 
+    ARM::Shared sharedThumb("Thumb");
+
+    ARM::ThumbGenerator generatorThumb9(sharedThumb, ARM::Family::ARM946ES);
+    generatorThumb9.generate();
+
+    ARM::ThumbGenerator generatorThumb7(sharedThumb, ARM::Family::ARM7TDMI);
+    generatorThumb7.generate();
+
+    sharedThumb.exportSymbols("CpuArmThumbSymbols.inl");
+    sharedThumb.exportTables("CpuArmThumbTables.inl");
+    generatorThumb7.exportTables("CpuTablesThumbARM7TDMI.inl");
+    generatorThumb9.exportTables("CpuTablesThumbARM946ES.inl");
+
     return 0;
 }
\ No newline at end of file
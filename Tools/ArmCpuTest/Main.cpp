@@ -0,0 +1,368 @@
+#include <Core/Clock.h>
+#include <Core/CpuARM946ES.h>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    using namespace emu;
+
+    const uint32_t  RAM_BASE = 0x02000000;
+    const uint32_t  RAM_SIZE = 0x10000;
+    const uint32_t  DEVICE_BASE = 0x04000000;
+    const uint32_t  DEVICE_SIZE = 0x1000;
+    const uint32_t  DEVICE_HALT = 0x00;
+    const uint32_t  DEVICE_WAIT = 0x04;
+    const uint32_t  BRANCH_SELF = 0xeafffffe;
+
+    // Interrupt controller raising its lines from scheduler events, writes halt the CPU or wait for a mask
+    class Device
+    {
+    public:
+        void create(CpuArm& cpu, Scheduler& scheduler)
+        {
+            mCpu = &cpu;
+            mScheduler = &scheduler;
+            mEvent.setCallback(Scheduler::Callback::make<Device, &Device::onEvent>(this));
+        }
+
+        ~Device()
+        {
+            if (mScheduler)
+                mScheduler->cancel(mEvent);
+        }
+
+        uint32_t read32(uint32_t)
+        {
+            return mPending;
+        }
+
+        void write32(uint32_t addr, uint32_t value)
+        {
+            if (addr == DEVICE_BASE + DEVICE_HALT)
+                mCpu->halt();
+            else if (addr == DEVICE_BASE + DEVICE_WAIT)
+                mCpu->waitForInterrupt(value);
+        }
+
+        void raise(uint32_t irq)
+        {
+            mPending |= EMU_BIT(irq);
+            mCpu->wake();
+        }
+
+        // Raises each interrupt at its tick, in order
+        void schedule(const std::vector<std::pair<Tick, uint32_t>>& interrupts)
+        {
+            mInterrupts = interrupts;
+            mNext = 0;
+            if (!mInterrupts.empty())
+                mScheduler->schedule(mEvent, mInterrupts[0].first);
+        }
+
+        uint32_t getPendingInterrupts()
+        {
+            return mPending;
+        }
+
+    private:
+        void onEvent(Tick)
+        {
+            raise(mInterrupts[mNext++].second);
+            if (mNext < mInterrupts.size())
+                mScheduler->schedule(mEvent, mInterrupts[mNext].first);
+        }
+
+        CpuArm*         mCpu{ nullptr };
+        Scheduler*      mScheduler{ nullptr };
+        Scheduler::Event mEvent;
+        std::vector<std::pair<Tick, uint32_t>> mInterrupts;
+        size_t          mNext{ 0 };
+        uint32_t        mPending{ 0 };
+    };
+
+    // Programs end with a SWI, the cycle count and the SWI number are taken there
+    class TestCpu : public ARM946ES
+    {
+    public:
+        using CpuArm::CPSR_T;
+
+        int64_t getEndCycles() const
+        {
+            return mEndCycles;
+        }
+
+        uint32_t getSwiNumber() const
+        {
+            return mSwiNumber;
+        }
+
+    protected:
+        virtual void swi(uint32_t number) override
+        {
+            if (mEndCycles >= 0)
+                return;
+            mEndCycles = mExecutedCycles + mAccessCycles;
+            mSwiNumber = number;
+        }
+
+    private:
+        int64_t     mEndCycles{ -1 };
+        uint32_t    mSwiNumber{ 0 };
+    };
+
+    // A CPU with RAM and the device, all running on the clock with a short quantum
+    class System
+    {
+    public:
+        bool create(const std::vector<uint32_t>& program, bool thumb = false)
+        {
+            Clock::Config clockConfig;
+            clockConfig.minQuantum = QUANTUM;
+            clockConfig.maxQuantum = QUANTUM;
+            EMU_VERIFY(mClock.create(clockConfig));
+            mRam.assign(RAM_SIZE, 0);
+            mDevice.create(mCpu, mClock.getScheduler());
+            mAccessorRAM.setName("RAM").setMemoryWritable(mRam.data()).setTiming(32, 1, 1);
+            mAccessorDevice.setName("Device").setTiming(32, 1, 1)
+                .setReadFunc(MemoryBus32::ReadDelegate32::make<Device, &Device::read32>(&mDevice))
+                .setWriteFunc(MemoryBus32::WriteDelegate32::make<Device, &Device::write32>(&mDevice));
+            EMU_VERIFY(mMemory.create(28, 12));
+            EMU_VERIFY(mMemory.addRange(RAM_BASE, RAM_SIZE, mAccessorRAM));
+            EMU_VERIFY(mMemory.addRange(DEVICE_BASE, DEVICE_SIZE, mAccessorDevice));
+            mMemory.write(RAM_BASE, program.data(), program.size());
+
+            CpuArm::Config config;
+            config.skipIdleLoops = false;
+            EMU_VERIFY(mCpu.create(config, mMemory, mClock, 1));
+            mCpu.setInterruptDelegate(CpuArm::InterruptDelegate::make<Device, &Device::getPendingInterrupts>(&mDevice));
+            mCpu.reset();
+
+            auto& registers = const_cast<CpuArm::Registers&>(mCpu.getRegisters());
+            registers.r[13] = DEVICE_BASE;
+            if (thumb)
+                registers.cpsr |= EMU_BIT(TestCpu::CPSR_T);
+            mCpu.setPC(RAM_BASE);
+            return true;
+        }
+
+        static const Tick   QUANTUM = 16;
+
+        Clock               mClock;
+        std::vector<uint8_t> mRam;
+        Device              mDevice;
+        MemoryBus32::Accessor mAccessorRAM;
+        MemoryBus32::Accessor mAccessorDevice;
+        MemoryBus32         mMemory;
+        TestCpu             mCpu;
+    };
+
+    // Directed tests for CPU states the random programs of ArmCpuCompare do not reach
+    class Application
+    {
+    public:
+        bool run()
+        {
+            static const struct
+            {
+                const char* name;
+                bool        (*func)();
+            } tests[] =
+            {
+                { "halt idles until woken", testHaltWake },
+                { "wait ignores other interrupts", testWaitMask },
+                { "halt with a pending interrupt", testHaltPending },
+                { "thumb branches", testThumbBranches },
+                { "thumb swi number", testThumbSwi },
+                { "other bus writes code through a mirror", testSharedCodeWriteBlocks },
+                { "other bus writes JIT code through a mirror", testSharedCodeWriteJit },
+            };
+
+            uint32_t failures = 0;
+            for (const auto& test : tests)
+            {
+                if (test.func())
+                    continue;
+                printf("%s failed\n", test.name);
+                ++failures;
+            }
+            printf("%u tests, %u failures\n", static_cast<uint32_t>(sizeof(tests) / sizeof(tests[0])), failures);
+            return failures == 0;
+        }
+
+    private:
+        // str r0, [r13, #offset]; mov r1, #1; swi 0
+        static std::vector<uint32_t> makeStoreProgram(uint32_t offset)
+        {
+            return { 0xe58d0000 | offset, 0xe3a01001, 0xef000000, BRANCH_SELF };
+        }
+
+        // Thumb instructions packed two per word, the first one in the low half
+        static std::vector<uint32_t> makeThumbProgram(const std::vector<uint16_t>& insns)
+        {
+            std::vector<uint32_t> program((insns.size() + 1) / 2, 0);
+            for (size_t index = 0; index < insns.size(); ++index)
+                program[index / 2] |= insns[index] << ((index & 1) * 16);
+            return program;
+        }
+
+        static bool testHaltWake()
+        {
+            const Tick wakeTick = 10000;
+            System system;
+            EMU_VERIFY(system.create(makeStoreProgram(DEVICE_HALT)));
+            system.mDevice.schedule({ { wakeTick, 0 } });
+
+            // The halted CPU hands the clock whole slices up to the event instead of one per quantum
+            system.mClock.execute(wakeTick - 100);
+            EMU_VERIFY(system.mCpu.getRegisters().r[1] == 0);
+            EMU_VERIFY(system.mCpu.getIdleStats().haltedCycles > 0);
+            EMU_VERIFY(system.mClock.getQuantumStats().slices < 8);
+
+            system.mClock.execute(wakeTick + 100);
+            EMU_VERIFY(system.mCpu.getRegisters().r[1] == 1);
+            EMU_VERIFY(system.mCpu.getEndCycles() >= wakeTick);
+            return true;
+        }
+
+        static bool testWaitMask()
+        {
+            const Tick otherTick = 1000;
+            const Tick wakeTick = 2000;
+            System system;
+            auto& registers = const_cast<CpuArm::Registers&>(system.mCpu.getRegisters());
+            EMU_VERIFY(system.create(makeStoreProgram(DEVICE_WAIT)));
+            registers.r[0] = EMU_BIT(3);
+            system.mDevice.schedule({ { otherTick, 0 }, { wakeTick, 3 } });
+
+            system.mClock.execute(wakeTick - 1);
+            EMU_VERIFY(system.mCpu.getEndCycles() < 0);
+            system.mClock.execute(wakeTick + 100);
+            EMU_VERIFY(system.mCpu.getEndCycles() >= wakeTick);
+            return true;
+        }
+
+        static bool testHaltPending()
+        {
+            System system;
+            EMU_VERIFY(system.create(makeStoreProgram(DEVICE_HALT)));
+            system.mDevice.raise(5);
+
+            system.mClock.execute(100);
+            EMU_VERIFY(system.mCpu.getRegisters().r[1] == 1);
+            EMU_VERIFY(system.mCpu.getIdleStats().haltedCycles == 0);
+            return true;
+        }
+
+        static bool testSharedCodeWriteBlocks()
+        {
+            return testSharedCodeWrite(false);
+        }
+
+        static bool testSharedCodeWriteJit()
+        {
+            return testSharedCodeWrite(true);
+        }
+
+        static bool testThumbBranches()
+        {
+            System system;
+            EMU_VERIFY(system.create(makeThumbProgram(
+            {
+                0x2101,     // movs r1, #1
+                0x2901,     // cmp r1, #1
+                0xd001,     // beq skip1
+                0x2102,     // movs r1, #2
+                0x2103,     // movs r1, #3
+                0xe001,     // skip1: b skip2
+                0x2104,     // movs r1, #4
+                0x2105,     // movs r1, #5
+                0x2203,     // skip2: movs r2, #3
+                0x3101,     // loop: adds r1, #1
+                0x3a01,     // subs r2, #1
+                0xd1fc,     // bne loop
+                0xdf00,     // swi 0
+                0xe7fe,     // b .
+            }), true));
+
+            system.mClock.execute(1000);
+            EMU_VERIFY(system.mCpu.getEndCycles() >= 0);
+            EMU_VERIFY(system.mCpu.getRegisters().r[1] == 4);
+            EMU_VERIFY(system.mCpu.getRegisters().r[2] == 0);
+            return true;
+        }
+
+        // The SWI number shares the conditional branch encoding and must not be taken as an offset
+        static bool testThumbSwi()
+        {
+            System system;
+            EMU_VERIFY(system.create(makeThumbProgram({ 0xdfc5, 0xe7fe }), true));
+
+            system.mClock.execute(1000);
+            EMU_VERIFY(system.mCpu.getEndCycles() >= 0);
+            EMU_VERIFY(system.mCpu.getSwiNumber() == 0xc5);
+            return true;
+        }
+
+        // One CPU caches a block, the other one overwrites it through a mirror of the memory on its own bus
+        static bool testSharedCodeWrite(bool jit)
+        {
+            const uint32_t writerOffset = 0x8000;
+            const uint32_t movR1Two = 0xe3a01002;
+            std::vector<uint32_t> code = { 0xe3a01001, 0xef000000, BRANCH_SELF };
+            std::vector<uint32_t> writer = { 0xe5843000, BRANCH_SELF };
+
+            std::vector<uint8_t> ram(RAM_SIZE);
+            Clock clock;
+            EMU_VERIFY(clock.create(Clock::Config()));
+            MemoryBus32::DirtyTracker tracker;
+            EMU_VERIFY(tracker.create(RAM_SIZE));
+            MemoryBus32::Accessor accessors[2];
+            MemoryBus32 memories[2];
+            for (uint32_t index = 0; index < 2; ++index)
+            {
+                accessors[index].setName("RAM").setMemoryWritable(ram.data()).setDirtyTracker(tracker);
+                EMU_VERIFY(memories[index].create(28, 22));
+                EMU_VERIFY(memories[index].addMirroredRange(RAM_BASE, 0x1000000, RAM_SIZE - 1, accessors[index]));
+            }
+            memories[0].write(RAM_BASE, code.data(), code.size());
+            memories[1].write(RAM_BASE + writerOffset, writer.data(), writer.size());
+
+            CpuArm::Config config;
+            config.skipIdleLoops = false;
+            config.cacheBlocks = true;
+            config.jit = jit;
+            TestCpu reader;
+            EMU_VERIFY(reader.create(config, memories[0], clock, 1));
+            reader.reset();
+            auto& readerRegisters = const_cast<CpuArm::Registers&>(reader.getRegisters());
+            reader.setPC(RAM_BASE);
+            clock.execute(100);
+            EMU_VERIFY(readerRegisters.r[1] == 1);
+
+            // The store lands on the first page of the memory through its second mirror
+            TestCpu writerCpu;
+            EMU_VERIFY(writerCpu.create(config, memories[1], clock, 1));
+            writerCpu.reset();
+            auto& writerRegisters = const_cast<CpuArm::Registers&>(writerCpu.getRegisters());
+            writerRegisters.r[3] = movR1Two;
+            writerRegisters.r[4] = RAM_BASE + RAM_SIZE;
+            writerCpu.setPC(RAM_BASE + writerOffset);
+            clock.execute(200);
+            EMU_VERIFY(memories[0].read32(RAM_BASE) == movR1Two);
+
+            readerRegisters.r[1] = 0;
+            reader.setPC(RAM_BASE);
+            clock.execute(300);
+            EMU_VERIFY(readerRegisters.r[1] == 2);
+            return true;
+        }
+    };
+}
+
+int main()
+{
+    Application application;
+    bool success = application.run();
+    return success ? 0 : 1;
+}
@@ -122,6 +122,28 @@ application "ArmCpuGen"
         "Tools/ArmCpuGen/**.h", "Tools/ArmCpuGen/**.cpp",
     }
 
+application "ArmCpuCompare"
+    files
+    {
+        "Tools/ArmCpuCompare/**.h", "Tools/ArmCpuCompare/**.cpp",
+    }
+
+    links
+    {
+        "Core",
+    }
+
+application "ArmCpuTest"
+    files
+    {
+        "Tools/ArmCpuTest/**.h", "Tools/ArmCpuTest/**.cpp",
+    }
+
+    links
+    {
+        "Core",
+    }
+
 application "ArmCpuReplay"
     files
     {